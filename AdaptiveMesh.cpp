@@ -0,0 +1,86 @@
+#include "AdaptiveMesh.hpp"
+#include <algorithm>
+#include <cmath>
+
+std::vector<double> makeInitialMesh(int n, double xi) {
+    const double h = 1.0 / n;
+    std::vector<double> x;
+    x.reserve(n + 2);
+    for (int i = 0; i <= n; ++i) {
+        x.push_back(i * h);
+    }
+
+    // Узел в точке xi, если она внутренняя и не совпадает с узлом сетки
+    if (xi > 0.0 && xi < 1.0) {
+        auto position = std::lower_bound(x.begin(), x.end(), xi);
+        const double tolerance = 1e-12;
+        if (*position - xi > tolerance && xi - *(position - 1) > tolerance) {
+            x.insert(position, xi);
+        }
+    }
+    return x;
+}
+
+void estimateIntervalErrors(const std::vector<double>& x, const std::vector<double>& u,
+                            std::vector<double>& errors) {
+    const size_t intervals = x.size() - 1;
+    errors.assign(intervals, 0.0);
+    if (intervals < 2) {
+        return;
+    }
+
+    // |u''| во внутренних узлах; в граничных — значение соседнего узла
+    double previous = 0.0;
+    for (size_t i = 1; i < intervals; ++i) {
+        const double hLeft = x[i] - x[i - 1];
+        const double hRight = x[i + 1] - x[i];
+        const double secondDerivative =
+            std::abs(2.0 * ((u[i + 1] - u[i]) / hRight - (u[i] - u[i - 1]) / hLeft) / (hLeft + hRight));
+
+        if (i == 1) {
+            previous = secondDerivative;
+        }
+        const double h = x[i] - x[i - 1];
+        errors[i - 1] = h * h * std::max(previous, secondDerivative) / 8.0;
+        previous = secondDerivative;
+    }
+    const double h = x[intervals] - x[intervals - 1];
+    errors[intervals - 1] = h * h * previous / 8.0;
+}
+
+void refineMesh(std::vector<double>& x, std::vector<char>& marked) {
+    const size_t intervals = x.size() - 1;
+    marked.resize(intervals, 0);
+
+    // Согласование: шаг после деления не должен быть больше соседнего более чем вдвое
+    auto newStep = [&](size_t i) {
+        const double h = x[i + 1] - x[i];
+        return marked[i] ? 0.5 * h : h;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i + 1 < intervals; ++i) {
+            if (!marked[i] && newStep(i) > 2.0 * newStep(i + 1)) {
+                marked[i] = 1;
+                changed = true;
+            }
+            if (!marked[i + 1] && newStep(i + 1) > 2.0 * newStep(i)) {
+                marked[i + 1] = 1;
+                changed = true;
+            }
+        }
+    }
+
+    const size_t added = static_cast<size_t>(std::count(marked.begin(), marked.end(), 1));
+    std::vector<double> refined;
+    refined.reserve(x.size() + added);
+    for (size_t i = 0; i < intervals; ++i) {
+        refined.push_back(x[i]);
+        if (marked[i]) {
+            refined.push_back(0.5 * (x[i] + x[i + 1]));
+        }
+    }
+    refined.push_back(x[intervals]);
+    x.swap(refined);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <vector>
+
+// Неравномерная сетка на [0, 1] для адаптивного сгущения (SolverModel::solveAdaptive)
+
+// Равномерная сетка из n разбиений с дополнительным узлом в точке xi
+std::vector<double> makeInitialMesh(int n, double xi);
+
+// Оценка ошибки на интервалах [x_i, x_{i+1}]: h_i^2 max|u''| / 8,
+// u'' — вторая разделённая разность в концах интервала
+void estimateIntervalErrors(const std::vector<double>& x, const std::vector<double>& u,
+                            std::vector<double>& errors);
+
+// Деление отмеченных интервалов пополам. Соседи отмеченных интервалов
+// дополнительно делятся, пока соседние шаги отличаются не более чем вдвое:
+// на резко неравномерной сетке схема теряет второй порядок
+void refineMesh(std::vector<double>& x, std::vector<char>& marked);
@@ -0,0 +1,266 @@
+#include "AdiSolver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Запуск body(worker) для каждого потока; исключения пробрасываются вызывающему
+template <typename Body>
+void forEachWorker(int workers, Body body) {
+    if (workers == 1) {
+        body(0); // Без потоков и выделений памяти
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    std::vector<std::exception_ptr> errors(workers);
+
+    for (int w = 1; w < workers; ++w) {
+        threads.emplace_back([&, w] {
+            try {
+                body(w);
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        });
+    }
+    try {
+        body(0);
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// Начало доли потока worker в диапазоне [0, count)
+size_t rangeBegin(size_t count, int worker, int workers) {
+    return count * worker / workers;
+}
+
+} // namespace
+
+AdiSolver::AdiSolver(int dimensions, int n, int threads) : m_dimensions(dimensions), m_n(n) {
+    if (dimensions != 2 && dimensions != 3) {
+        throw std::invalid_argument("Размерность задачи должна быть 2 или 3");
+    }
+    if (n < 2) {
+        throw std::invalid_argument("Число отрезков по оси должно быть не меньше 2");
+    }
+    m_threads = threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    m_workers.reserve(m_threads);
+    for (int w = 0; w < m_threads; ++w) {
+        m_workers.emplace_back(n + 1);
+    }
+}
+
+size_t AdiSolver::nodes() const {
+    const size_t size = m_n + 1;
+    return m_dimensions == 3 ? size * size * size : size * size;
+}
+
+size_t AdiSolver::index(int i, int j, int k) const {
+    const size_t size = m_n + 1;
+    return i + size * (j + size * k);
+}
+
+void AdiSolver::checkSize(const std::vector<double>& u, const std::vector<double>& f) const {
+    if (u.size() != nodes() || f.size() != nodes()) {
+        throw std::invalid_argument("Размер решения или правой части не равен числу узлов сетки");
+    }
+}
+
+void AdiSolver::prepareCoefficients(Worker& worker, double tau) const {
+    if (worker.tau == tau && !worker.a.empty()) {
+        return;
+    }
+    const size_t size = static_cast<size_t>(m_n + 1) * kTile;
+    worker.a.assign(size, 0.0);
+    worker.b.assign(size, 1.0);
+    worker.c.assign(size, 0.0);
+    worker.d.resize(size);
+    worker.u.resize(size);
+
+    // Внутренние строки: -r u_{t-1} + (1 + 2r) u_t - r u_{t+1}, r = τ / (2 h^2);
+    // крайние строки — условия Дирихле
+    const double r = 0.5 * tau * m_n * m_n;
+    for (size_t k = kTile; k < size - kTile; ++k) {
+        worker.a[k] = worker.c[k] = -r;
+        worker.b[k] = 1.0 + 2.0 * r;
+    }
+    worker.tau = tau;
+}
+
+void AdiSolver::sweep(int axis, std::vector<double>& u, const std::vector<double>& f, double tau) {
+    const size_t size = m_n + 1;
+    const size_t strides[3] = {1, size, size * size};
+    const size_t stride = strides[axis];
+
+    // Линии нумеруются двумя другими осями: быстрая идёт внутри плитки,
+    // медленная (только в 3D) перебирает плоскости
+    const int fast = axis == 0 ? 1 : 0;
+    const int slow = 3 - axis - fast;
+    const size_t fastStride = strides[fast];
+    const size_t slowStride = m_dimensions == 3 ? strides[slow] : 0;
+    const size_t slowCount = m_dimensions == 3 ? m_n - 1 : 1;
+    const size_t slowFirst = m_dimensions == 3 ? 1 : 0;
+    const size_t tilesPerSlow = (m_n - 1 + kTile - 1) / kTile;
+    const size_t tiles = slowCount * tilesPerSlow;
+    const int workers = static_cast<int>(std::min<size_t>(m_threads, tiles));
+
+    const double invH2 = static_cast<double>(m_n) * m_n;
+    const double half = 0.5 * tau * invH2;
+    const double full = tau * invH2;
+    const double* old = m_old.data();
+    const double* source = f.data();
+    double* out = u.data();
+    const size_t last = m_n;
+
+    forEachWorker(workers, [&](int w) {
+        Worker& worker = m_workers[w];
+        prepareCoefficients(worker, tau);
+        double* d = worker.d.data();
+        const double* solution = worker.u.data();
+        size_t lineStart[kTile];
+
+        const size_t end = rangeBegin(tiles, w + 1, workers);
+        for (size_t tile = rangeBegin(tiles, w, workers); tile < end; ++tile) {
+            const size_t slowIndex = slowFirst + tile / tilesPerSlow;
+            const size_t firstLine = 1 + (tile % tilesPerSlow) * kTile;
+            const size_t count = std::min<size_t>(kTile, m_n - firstLine);
+            // Неполная плитка дополняется копиями последней линии, которые не записываются
+            for (size_t s = 0; s < kTile; ++s) {
+                lineStart[s] = slowIndex * slowStride + (firstLine + std::min(s, count - 1)) * fastStride;
+            }
+
+            // Сборка правой части в плитку
+            for (size_t s = 0; s < kTile; ++s) {
+                d[s] = out[lineStart[s]];
+                d[last * kTile + s] = out[lineStart[s] + last * stride];
+            }
+            if (axis == 0) {
+                const size_t sy = strides[1];
+                const size_t sz = m_dimensions == 3 ? strides[2] : 0;
+                for (size_t t = 1; t < last; ++t) {
+                    double* row = d + t * kTile;
+                    for (size_t s = 0; s < kTile; ++s) {
+                        const size_t q = lineStart[s] + t;
+                        const double center = old[q];
+                        double other = old[q - sy] - 2.0 * center + old[q + sy];
+                        if (sz) {
+                            other += old[q - sz] - 2.0 * center + old[q + sz];
+                        }
+                        row[s] = center + half * (old[q - 1] - 2.0 * center + old[q + 1]) +
+                                 full * other + tau * source[q];
+                    }
+                }
+            } else {
+                for (size_t t = 1; t < last; ++t) {
+                    double* row = d + t * kTile;
+                    for (size_t s = 0; s < kTile; ++s) {
+                        const size_t q = lineStart[s] + t * stride;
+                        row[s] = out[q] - half * (old[q - stride] - 2.0 * old[q] + old[q + stride]);
+                    }
+                }
+            }
+
+            worker.solver.solve(worker.a.data(), worker.b.data(), worker.c.data(), d, worker.u.data());
+
+            for (size_t t = 1; t < last; ++t) {
+                const double* row = solution + t * kTile;
+                for (size_t s = 0; s < count; ++s) {
+                    out[lineStart[s] + t * stride] = row[s];
+                }
+            }
+        }
+    });
+}
+
+void AdiSolver::step(std::vector<double>& u, const std::vector<double>& f, double tau) {
+    checkSize(u, f);
+    if (!(tau > 0.0)) {
+        throw std::invalid_argument("Шаг по времени должен быть положительным");
+    }
+    m_old = u;
+    for (int axis = 0; axis < m_dimensions; ++axis) {
+        sweep(axis, u, f, tau);
+    }
+}
+
+double AdiSolver::residual(const std::vector<double>& u, const std::vector<double>& f) {
+    checkSize(u, f);
+    const size_t size = m_n + 1;
+    const size_t sy = size;
+    const size_t sz = size * size;
+    // Внутренние строки (j, k) делятся между потоками
+    const size_t rowsPerPlane = m_n - 1;
+    const size_t rows = m_dimensions == 3 ? rowsPerPlane * rowsPerPlane : rowsPerPlane;
+    const int workers = static_cast<int>(std::min<size_t>(m_threads, rows));
+    const double invH2 = static_cast<double>(m_n) * m_n;
+    const double* values = u.data();
+
+    forEachWorker(workers, [&](int w) {
+        double result = 0.0;
+        const size_t end = rangeBegin(rows, w + 1, workers);
+        for (size_t row = rangeBegin(rows, w, workers); row < end; ++row) {
+            const size_t k = m_dimensions == 3 ? row / rowsPerPlane + 1 : 0;
+            const size_t j = row % rowsPerPlane + 1;
+            const size_t first = k * sz + j * sy;
+            for (int i = 1; i < m_n; ++i) {
+                const size_t q = first + i;
+                const double center = values[q];
+                double laplacian = values[q - 1] - 2.0 * center + values[q + 1] +
+                                   values[q - sy] - 2.0 * center + values[q + sy];
+                if (m_dimensions == 3) {
+                    laplacian += values[q - sz] - 2.0 * center + values[q + sz];
+                }
+                result = std::max(result, std::fabs(laplacian * invH2 + f[q]));
+            }
+        }
+        m_workers[w].residual = result;
+    });
+
+    double result = 0.0;
+    for (int w = 0; w < workers; ++w) {
+        result = std::max(result, m_workers[w].residual);
+    }
+    return result;
+}
+
+int AdiSolver::solveSteady(std::vector<double>& u, const std::vector<double>& f,
+                           double tolerance, int maxIterations) {
+    checkSize(u, f);
+    double sourceNorm = 0.0;
+    for (double value : f) {
+        sourceNorm = std::max(sourceNorm, std::fabs(value));
+    }
+    const double target = tolerance * (sourceNorm > 0.0 ? sourceNorm : 1.0);
+
+    // Спектр -Λ на одной оси: λ = 4 / h^2 sin^2(π m h / 2), m = 1 .. n-1
+    const double angle = 0.5 * M_PI / m_n;
+    const double lambdaMin = 4.0 * m_n * m_n * std::sin(angle) * std::sin(angle);
+    const double lambdaMax = 4.0 * m_n * m_n * std::cos(angle) * std::cos(angle);
+    // Соседние параметры различаются не более чем в 4 раза
+    const int cycle = 1 + static_cast<int>(std::ceil(std::log(lambdaMax / lambdaMin) / std::log(4.0)));
+
+    int iterations = 0;
+    while (iterations < maxIterations) {
+        for (int m = 0; m < cycle && iterations < maxIterations; ++m, ++iterations) {
+            const double lambda = lambdaMin * std::pow(lambdaMax / lambdaMin, static_cast<double>(m) / (cycle - 1));
+            step(u, f, 2.0 / lambda);
+        }
+        if (residual(u, f) <= target) {
+            return iterations;
+        }
+    }
+    throw std::runtime_error("Итерации ADI не достигли заданной невязки");
+}
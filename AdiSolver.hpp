@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "BatchThomasSolver.hpp"
+
+// Метод переменных направлений (ADI) для уравнения u_t = Δu + f в единичном
+// квадрате или кубе на равномерной сетке с n отрезками по каждой оси.
+// Узел (i, j, k) хранится по индексу i + (n+1) (j + (n+1) k); граничные узлы
+// задают условия Дирихле и не меняются.
+// Каждый полушаг — (n-1)^(d-1) независимых прогонок вдоль одной оси. Линии
+// группируются в плитки по kTile: элемент t линии s плитки лежит в буфере
+// по индексу t * kTile + s, и плитка решается пакетной прогонкой
+// (BatchThomasSolver). Вдоль y и z соседние линии плитки соседствуют в памяти,
+// вдоль x плитка собирается транспонированием; правая часть вычисляется
+// при сборке. Плитки делятся между потоками непрерывными диапазонами.
+class AdiSolver {
+public:
+    static const int kTile = 8; // Линий в плитке: один вектор AVX-512
+
+    // dimensions = 2 или 3; threads = 0 — по числу аппаратных потоков
+    AdiSolver(int dimensions, int n, int threads = 0);
+
+    int dimensions() const { return m_dimensions; }
+    int n() const { return m_n; }
+    int threads() const { return m_threads; }
+    size_t nodes() const;
+    size_t index(int i, int j, int k = 0) const;
+
+    // Шаг схемы Дугласа с весом 1/2 (Кранк — Николсон по каждому направлению):
+    //   (1 - τ/2 Λx) u*   = (1 + τ/2 Λx + τ Λy + τ Λz) u + τ f,
+    //   (1 - τ/2 Λy) u**  = u*  - τ/2 Λy u,
+    //   (1 - τ/2 Λz) u^+  = u** - τ/2 Λz u.
+    // Безусловно устойчива, второй порядок по τ; в 2D совпадает со схемой
+    // Писмена — Рэкфорда. f и u длины nodes()
+    void step(std::vector<double>& u, const std::vector<double>& f, double tau);
+
+    // Стационарная задача -Δu = f: шаги step с циклом τ_m = 2 / λ_m, где λ_m
+    // геометрически заполняют спектр одномерного оператора [λmin, λmax].
+    // Останавливается, когда residual(u, f) <= tolerance * max |f|;
+    // возвращает число шагов
+    int solveSteady(std::vector<double>& u, const std::vector<double>& f,
+                    double tolerance, int maxIterations = 1000);
+
+    // max |Δu + f| по внутренним узлам
+    double residual(const std::vector<double>& u, const std::vector<double>& f);
+
+private:
+    // Рабочие массивы потока: коэффициенты плитки зависят только от τ
+    struct Worker {
+        explicit Worker(int size) : solver(size, kTile) {}
+        BatchThomasSolver solver;
+        std::vector<double> a, b, c, d, u;
+        double tau = 0.0;
+        double residual = 0.0;
+    };
+
+    void checkSize(const std::vector<double>& u, const std::vector<double>& f) const;
+    void sweep(int axis, std::vector<double>& u, const std::vector<double>& f, double tau);
+    void prepareCoefficients(Worker& worker, double tau) const;
+
+    int m_dimensions;
+    int m_n;
+    int m_threads;
+    std::vector<Worker> m_workers;
+    std::vector<double> m_old; // u в начале шага: нужен всем полушагам
+};
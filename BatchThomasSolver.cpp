@@ -0,0 +1,240 @@
+#include "BatchThomasSolver.hpp"
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_THOMAS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const double kZeroPivot = 1e-12; // Порог из SolverModel::thomasAlgorithm
+
+[[noreturn]] void throwZeroPivot() {
+    throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+}
+
+enum class Isa { Scalar, Avx2, Avx512 };
+
+Isa detectIsa() {
+#ifdef BATCH_THOMAS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+    if (__builtin_cpu_supports("avx2")) return Isa::Avx2;
+#endif
+    return Isa::Scalar;
+}
+
+Isa currentIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+// Шаги прогонки для одной системы; используются скалярным путём и для хвоста пакета
+inline void forwardFirst(std::size_t k, const double* b, const double* c, const double* d,
+                         double* p, double* u) {
+    p[k] = -c[k] / b[k];
+    u[k] = d[k] / b[k];
+}
+
+inline void forwardStep(std::size_t k, std::size_t prev, const double* a, const double* b,
+                        const double* c, const double* d, double* p, double* u) {
+    double denom = b[k] + a[k] * p[prev];
+    if (std::fabs(denom) < kZeroPivot) {
+        throwZeroPivot();
+    }
+    p[k] = -c[k] / denom;
+    u[k] = (d[k] - a[k] * u[prev]) / denom;
+}
+
+inline void backwardStep(std::size_t k, std::size_t next, const double* p, double* u) {
+    u[k] = p[k] * u[next] + u[k];
+}
+
+// Все системы пакета начиная с first обрабатываются скалярно
+void sweepScalar(int n, int batch, int first, const double* a, const double* b,
+                 const double* c, const double* d, double* p, double* u) {
+    const std::size_t stride = batch;
+
+    // Прямой ход
+    for (int s = first; s < batch; ++s) {
+        forwardFirst(s, b, c, d, p, u);
+    }
+    for (int i = 1; i < n; ++i) {
+        const std::size_t row = i * stride;
+        for (int s = first; s < batch; ++s) {
+            forwardStep(row + s, row - stride + s, a, b, c, d, p, u);
+        }
+    }
+
+    // Обратный ход
+    for (int i = n - 2; i >= 0; --i) {
+        const std::size_t row = i * stride;
+        for (int s = first; s < batch; ++s) {
+            backwardStep(row + s, row + stride + s, p, u);
+        }
+    }
+}
+
+#ifdef BATCH_THOMAS_X86
+
+// Четыре системы на регистр; возвращает число обработанных систем
+__attribute__((target("avx2")))
+int sweepAvx2(int n, int batch, const double* a, const double* b,
+              const double* c, const double* d, double* p, double* u) {
+    const int width = 4;
+    const int vectorized = batch - batch % width;
+    const std::size_t stride = batch;
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d zeroPivot = _mm256_set1_pd(kZeroPivot);
+
+    // Прямой ход
+    for (int s = 0; s < vectorized; s += width) {
+        __m256d bv = _mm256_loadu_pd(b + s);
+        _mm256_storeu_pd(p + s, _mm256_div_pd(_mm256_xor_pd(_mm256_loadu_pd(c + s), signMask), bv));
+        _mm256_storeu_pd(u + s, _mm256_div_pd(_mm256_loadu_pd(d + s), bv));
+    }
+    for (int i = 1; i < n; ++i) {
+        const std::size_t row = i * stride;
+        const std::size_t prev = row - stride;
+        for (int s = 0; s < vectorized; s += width) {
+            __m256d av = _mm256_loadu_pd(a + row + s);
+            __m256d denom = _mm256_add_pd(_mm256_loadu_pd(b + row + s),
+                                          _mm256_mul_pd(av, _mm256_loadu_pd(p + prev + s)));
+            __m256d absDenom = _mm256_andnot_pd(signMask, denom);
+            if (_mm256_movemask_pd(_mm256_cmp_pd(absDenom, zeroPivot, _CMP_LT_OQ)) != 0) {
+                throwZeroPivot();
+            }
+            __m256d negC = _mm256_xor_pd(_mm256_loadu_pd(c + row + s), signMask);
+            __m256d rhs = _mm256_sub_pd(_mm256_loadu_pd(d + row + s),
+                                        _mm256_mul_pd(av, _mm256_loadu_pd(u + prev + s)));
+            _mm256_storeu_pd(p + row + s, _mm256_div_pd(negC, denom));
+            _mm256_storeu_pd(u + row + s, _mm256_div_pd(rhs, denom));
+        }
+    }
+
+    // Обратный ход
+    for (int i = n - 2; i >= 0; --i) {
+        const std::size_t row = i * stride;
+        const std::size_t next = row + stride;
+        for (int s = 0; s < vectorized; s += width) {
+            __m256d value = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(p + row + s),
+                                                        _mm256_loadu_pd(u + next + s)),
+                                          _mm256_loadu_pd(u + row + s));
+            _mm256_storeu_pd(u + row + s, value);
+        }
+    }
+
+    return vectorized;
+}
+
+// Восемь систем на регистр; возвращает число обработанных систем
+__attribute__((target("avx512f")))
+int sweepAvx512(int n, int batch, const double* a, const double* b,
+                const double* c, const double* d, double* p, double* u) {
+    const int width = 8;
+    const int vectorized = batch - batch % width;
+    const std::size_t stride = batch;
+    const __m512d zeroPivot = _mm512_set1_pd(kZeroPivot);
+    // Смена знака вычитанием из -0.0 даёт ровно -c, как в скалярном коде
+    const __m512d negZero = _mm512_set1_pd(-0.0);
+
+    // Прямой ход
+    for (int s = 0; s < vectorized; s += width) {
+        __m512d bv = _mm512_loadu_pd(b + s);
+        __m512d negC = _mm512_sub_pd(negZero, _mm512_loadu_pd(c + s));
+        _mm512_storeu_pd(p + s, _mm512_div_pd(negC, bv));
+        _mm512_storeu_pd(u + s, _mm512_div_pd(_mm512_loadu_pd(d + s), bv));
+    }
+    for (int i = 1; i < n; ++i) {
+        const std::size_t row = i * stride;
+        const std::size_t prev = row - stride;
+        for (int s = 0; s < vectorized; s += width) {
+            __m512d av = _mm512_loadu_pd(a + row + s);
+            __m512d denom = _mm512_add_pd(_mm512_loadu_pd(b + row + s),
+                                          _mm512_mul_pd(av, _mm512_loadu_pd(p + prev + s)));
+            if (_mm512_cmp_pd_mask(_mm512_abs_pd(denom), zeroPivot, _CMP_LT_OQ) != 0) {
+                throwZeroPivot();
+            }
+            __m512d negC = _mm512_sub_pd(negZero, _mm512_loadu_pd(c + row + s));
+            __m512d rhs = _mm512_sub_pd(_mm512_loadu_pd(d + row + s),
+                                        _mm512_mul_pd(av, _mm512_loadu_pd(u + prev + s)));
+            _mm512_storeu_pd(p + row + s, _mm512_div_pd(negC, denom));
+            _mm512_storeu_pd(u + row + s, _mm512_div_pd(rhs, denom));
+        }
+    }
+
+    // Обратный ход
+    for (int i = n - 2; i >= 0; --i) {
+        const std::size_t row = i * stride;
+        const std::size_t next = row + stride;
+        for (int s = 0; s < vectorized; s += width) {
+            __m512d value = _mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(p + row + s),
+                                                        _mm512_loadu_pd(u + next + s)),
+                                          _mm512_loadu_pd(u + row + s));
+            _mm512_storeu_pd(u + row + s, value);
+        }
+    }
+
+    return vectorized;
+}
+
+#endif // BATCH_THOMAS_X86
+
+} // namespace
+
+BatchThomasSolver::BatchThomasSolver(int size, int batch)
+    : m_size(size), m_batch(batch) {
+    if (size < 1 || batch < 1) {
+        throw std::invalid_argument("Размер системы и пакета должны быть положительными");
+    }
+    m_p.resize(static_cast<std::size_t>(size) * batch);
+}
+
+void BatchThomasSolver::solve(const double* a, const double* b, const double* c,
+                              const double* d, double* u) {
+    double* p = m_p.data();
+    int done = 0;
+
+#ifdef BATCH_THOMAS_X86
+    switch (currentIsa()) {
+    case Isa::Avx512:
+        done = sweepAvx512(m_size, m_batch, a, b, c, d, p, u);
+        break;
+    case Isa::Avx2:
+        done = sweepAvx2(m_size, m_batch, a, b, c, d, p, u);
+        break;
+    case Isa::Scalar:
+        break;
+    }
+#endif
+
+    // Системы, не заполнившие целый регистр
+    if (done < m_batch) {
+        sweepScalar(m_size, m_batch, done, a, b, c, d, p, u);
+    }
+}
+
+void BatchThomasSolver::solve(const std::vector<double>& a,
+                              const std::vector<double>& b,
+                              const std::vector<double>& c,
+                              const std::vector<double>& d,
+                              std::vector<double>& u) {
+    const std::size_t total = m_p.size();
+    if (a.size() != total || b.size() != total || c.size() != total || d.size() != total) {
+        throw std::invalid_argument("Размер массивов не соответствует пакету");
+    }
+    u.resize(total);
+    solve(a.data(), b.data(), c.data(), d.data(), u.data());
+}
+
+const char* BatchThomasSolver::instructionSet() {
+    switch (currentIsa()) {
+    case Isa::Avx512: return "avx512";
+    case Isa::Avx2: return "avx2";
+    case Isa::Scalar: break;
+    }
+    return "scalar";
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+// Пакетный метод прогонки для множества независимых систем одинакового размера.
+// Коэффициенты хранятся вперемешку (structure-of-arrays): элемент i системы s
+// расположен по индексу i * batch + s, поэтому прямой и обратный ход идут
+// сразу по нескольким системам в SIMD-регистрах (AVX-512 / AVX2 / скалярно).
+// Арифметика повторяет SolverModel::thomasAlgorithm операция в операцию,
+// так что результат для каждой системы совпадает со скалярным побитово
+// (при сборке без сжатия умножения и сложения в FMA, см. SolverCore.pri);
+// это проверяет ядро batchThomas в thomasAlgorithmBench.
+class BatchThomasSolver {
+public:
+    BatchThomasSolver(int size, int batch);
+
+    int size() const { return m_size; }
+    int batch() const { return m_batch; }
+
+    // Решение всех систем пакета; массивы длины size * batch
+    void solve(const double* a, const double* b, const double* c, const double* d, double* u);
+    void solve(const std::vector<double>& a,
+               const std::vector<double>& b,
+               const std::vector<double>& c,
+               const std::vector<double>& d,
+               std::vector<double>& u);
+
+    // Набор инструкций, выбранный при запуске: "avx512", "avx2" или "scalar"
+    static const char* instructionSet();
+
+private:
+    int m_size;
+    int m_batch;
+    std::vector<double> m_p; // Прогоночные коэффициенты p; q хранятся прямо в u
+};
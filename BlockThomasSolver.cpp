@@ -0,0 +1,122 @@
+#include "BlockThomasSolver.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Решение M X = R для блока N x N и K правых частей (столбцы R) методом Гаусса
+// с выбором главного элемента по столбцу; M и R портятся, ответ остаётся в R
+template <int N, int K>
+void solveBlock(double (&m)[N][N], double (&r)[N][K]) {
+    double inverse[N]; // 1 / ведущий элемент: деления только на прямом ходе
+    for (int col = 0; col < N; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < N; ++row) {
+            if (std::fabs(m[row][col]) > std::fabs(m[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(m[pivot][col]) < 1e-12) {
+            throw std::runtime_error("Вырожденный диагональный блок в матричной прогонке");
+        }
+        if (pivot != col) {
+            for (int k = 0; k < N; ++k) std::swap(m[pivot][k], m[col][k]);
+            for (int k = 0; k < K; ++k) std::swap(r[pivot][k], r[col][k]);
+        }
+        inverse[col] = 1.0 / m[col][col];
+        for (int row = col + 1; row < N; ++row) {
+            const double factor = m[row][col] * inverse[col];
+            for (int k = col + 1; k < N; ++k) m[row][k] -= factor * m[col][k];
+            for (int k = 0; k < K; ++k) r[row][k] -= factor * r[col][k];
+        }
+    }
+    for (int col = N - 1; col >= 0; --col) {
+        for (int k = 0; k < K; ++k) {
+            double value = r[col][k];
+            for (int j = col + 1; j < N; ++j) value -= m[col][j] * r[j][k];
+            r[col][k] = value * inverse[col];
+        }
+    }
+}
+
+} // namespace
+
+template <int N>
+void BlockThomasSolver<N>::solve(const std::vector<double>& a,
+                                 const std::vector<double>& b,
+                                 const std::vector<double>& c,
+                                 const std::vector<double>& d,
+                                 std::vector<double>& u) {
+    const size_t blockSize = N * N;
+    const size_t n = d.size() / N;
+    if (n == 0 || d.size() != n * N || a.size() != n * blockSize ||
+        b.size() != n * blockSize || c.size() != n * blockSize) {
+        throw std::invalid_argument("Размеры блочных диагоналей и правой части не совпадают");
+    }
+    if (&u == &d) {
+        throw std::invalid_argument("Решение не может записываться в правую часть");
+    }
+    m_p.resize(n * blockSize);
+    u.resize(n * N);
+
+    // Прямой ход: M = B_i + A_i P_{i-1}, [P_i | Q_i] = M^{-1} [-C_i | D_i - A_i Q_{i-1}];
+    // Q_i записывается сразу в u
+    double m[N][N];
+    double r[N][N + 1];
+    for (size_t i = 0; i < n; ++i) {
+        const double* ai = a.data() + i * blockSize;
+        const double* bi = b.data() + i * blockSize;
+        const double* ci = c.data() + i * blockSize;
+        const double* di = d.data() + i * N;
+        for (int row = 0; row < N; ++row) {
+            for (int col = 0; col < N; ++col) {
+                m[row][col] = bi[row * N + col];
+                r[row][col] = -ci[row * N + col];
+            }
+            r[row][N] = di[row];
+        }
+        if (i > 0) {
+            const double* prevP = m_p.data() + (i - 1) * blockSize;
+            const double* prevQ = u.data() + (i - 1) * N;
+            for (int row = 0; row < N; ++row) {
+                for (int k = 0; k < N; ++k) {
+                    const double factor = ai[row * N + k];
+                    for (int col = 0; col < N; ++col) {
+                        m[row][col] += factor * prevP[k * N + col];
+                    }
+                    r[row][N] -= factor * prevQ[k];
+                }
+            }
+        }
+
+        solveBlock<N, N + 1>(m, r);
+
+        double* pi = m_p.data() + i * blockSize;
+        double* qi = u.data() + i * N;
+        for (int row = 0; row < N; ++row) {
+            for (int col = 0; col < N; ++col) {
+                pi[row * N + col] = r[row][col];
+            }
+            qi[row] = r[row][N];
+        }
+    }
+
+    // Обратный ход: U_i = P_i U_{i+1} + Q_i
+    for (size_t i = n - 1; i-- > 0;) {
+        const double* pi = m_p.data() + i * blockSize;
+        const double* next = u.data() + (i + 1) * N;
+        double* ui = u.data() + i * N;
+        for (int row = 0; row < N; ++row) {
+            double value = ui[row];
+            for (int col = 0; col < N; ++col) {
+                value += pi[row * N + col] * next[col];
+            }
+            ui[row] = value;
+        }
+    }
+}
+
+template class BlockThomasSolver<2>;
+template class BlockThomasSolver<3>;
+template class BlockThomasSolver<4>;
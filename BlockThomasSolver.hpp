@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+// Матричная прогонка для блочно-трёхдиагональной системы
+//   A_i U_{i-1} + B_i U_i + C_i U_{i+1} = D_i,  i = 0 .. n-1,
+// с блоками N x N (N = 2, 3, 4 — связанные системы из нескольких уравнений).
+// Блоки хранятся подряд по строкам: блок i занимает [i N^2, (i+1) N^2),
+// векторы D и U — [i N, (i+1) N). A_0 и C_{n-1} не используются.
+// Размер блока известен при компиляции, поэтому обращение диагонального
+// блока (метод Гаусса с выбором главного элемента) полностью разворачивается;
+// сложность O(n N^3).
+template <int N>
+class BlockThomasSolver {
+    static_assert(N >= 2 && N <= 4, "Поддерживаются блоки 2x2, 3x3 и 4x4");
+
+public:
+    static constexpr int kBlockSize = N;
+
+    // Количество блочных строк n = d.size() / N; u не может совпадать с d
+    void solve(const std::vector<double>& a,
+               const std::vector<double>& b,
+               const std::vector<double>& c,
+               const std::vector<double>& d,
+               std::vector<double>& u);
+
+private:
+    std::vector<double> m_p; // Прогоночные блоки P_i = -(B_i + A_i P_{i-1})^{-1} C_i
+};
+
+extern template class BlockThomasSolver<2>;
+extern template class BlockThomasSolver<3>;
+extern template class BlockThomasSolver<4>;
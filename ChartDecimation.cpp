@@ -0,0 +1,51 @@
+#include "ChartDecimation.hpp"
+#include <QtCharts/QAbstractAxis>
+#include <QtCharts/QXYSeries>
+#include <limits>
+
+using namespace QtCharts;
+
+int chartPixelWidth(const QChartView* view) {
+    int width = static_cast<int>(view->chart()->plotArea().width());
+    if (width <= 0) {
+        width = view->width();
+    }
+    return std::max(width, 100);
+}
+
+void fitAxesToSeries(QChart* chart) {
+    double minX = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double minY = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+
+    for (QAbstractSeries* series : chart->series()) {
+        QXYSeries* xySeries = qobject_cast<QXYSeries*>(series);
+        if (!xySeries) {
+            continue;
+        }
+        for (const QPointF& point : xySeries->pointsVector()) {
+            if (!std::isfinite(point.y())) {
+                continue;
+            }
+            minX = std::min(minX, point.x());
+            maxX = std::max(maxX, point.x());
+            minY = std::min(minY, point.y());
+            maxY = std::max(maxY, point.y());
+        }
+    }
+    if (minX > maxX) {
+        return;
+    }
+    if (minY == maxY) {
+        minY -= 1.0;
+        maxY += 1.0;
+    }
+
+    for (QAbstractAxis* axis : chart->axes(Qt::Horizontal)) {
+        axis->setRange(minX, maxX);
+    }
+    for (QAbstractAxis* axis : chart->axes(Qt::Vertical)) {
+        axis->setRange(minY, maxY);
+    }
+}
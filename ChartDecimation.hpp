@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+#include <QtCharts/QChart>
+#include <QtCharts/QChartView>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Прореживание рядов для графиков: на каждый пиксель ширины остаются минимум
+// и максимум попавших в него узлов, поэтому пики ошибки сохраняются, а число
+// точек не превышает удвоенной ширины графика.
+// x — узлы (std::vector или GridView), y(i) — значение в узле i (решение, ошибка и т.п.),
+// вычисляется на лету.
+template<class Nodes, class YFunction>
+QVector<QPointF> decimateMinMax(const Nodes& x, YFunction y, int pixelWidth) {
+    const size_t count = x.size();
+    const size_t buckets = static_cast<size_t>(std::max(pixelWidth, 1));
+    QVector<QPointF> points;
+
+    if (count <= 2 * buckets) {
+        points.reserve(static_cast<int>(count));
+        for (size_t i = 0; i < count; ++i) {
+            points.append(QPointF(x[i], y(i)));
+        }
+        return points;
+    }
+
+    points.reserve(static_cast<int>(2 * buckets + 2));
+    points.append(QPointF(x[0], y(0)));
+    for (size_t bucket = 0; bucket < buckets; ++bucket) {
+        const size_t begin = 1 + bucket * (count - 2) / buckets;
+        const size_t end = 1 + (bucket + 1) * (count - 2) / buckets;
+        if (begin == end) {
+            continue;
+        }
+
+        size_t minIndex = begin;
+        size_t maxIndex = begin;
+        double minValue = y(begin);
+        double maxValue = minValue;
+        for (size_t i = begin + 1; i < end; ++i) {
+            double value = y(i);
+            if (value < minValue) {
+                minValue = value;
+                minIndex = i;
+            } else if (value > maxValue) {
+                maxValue = value;
+                maxIndex = i;
+            }
+        }
+
+        // Точки идут в порядке узлов, чтобы линия не возвращалась назад
+        if (minIndex == maxIndex) {
+            points.append(QPointF(x[minIndex], minValue));
+        } else if (minIndex < maxIndex) {
+            points.append(QPointF(x[minIndex], minValue));
+            points.append(QPointF(x[maxIndex], maxValue));
+        } else {
+            points.append(QPointF(x[maxIndex], maxValue));
+            points.append(QPointF(x[minIndex], minValue));
+        }
+    }
+    points.append(QPointF(x[count - 1], y(count - 1)));
+    return points;
+}
+
+// Значения, которые вычисляются блоками через source.evaluate(first, count, out)
+// (AnalyticalView) в небольшой буфер, без массива на всю сетку. decimateMinMax
+// обходит узлы по возрастанию, поэтому каждый блок вычисляется один раз
+template<class Source>
+class BlockValues {
+public:
+    explicit BlockValues(const Source& source) : m_source(source) {}
+
+    double operator()(size_t i) {
+        if (i < m_first || i - m_first >= m_count) {
+            m_first = i;
+            m_count = std::min(blockSize, m_source.size() - i);
+            m_source.evaluate(m_first, m_count, m_values);
+        }
+        return m_values[i - m_first];
+    }
+
+private:
+    static constexpr size_t blockSize = 256;
+
+    const Source& m_source;
+    size_t m_first = 0;
+    size_t m_count = 0;
+    double m_values[blockSize];
+};
+
+// Ширина области построения в пикселях; до первого показа — ширина виджета
+int chartPixelWidth(const QtCharts::QChartView* view);
+
+// Диапазоны осей по точкам всех рядов графика (ряды уже прорежены)
+void fitAxesToSeries(QtCharts::QChart* chart);
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "VectorMath.hpp"
+
+// Задача -k u'' + q u = f задаётся политикой коэффициентов — классом
+// со статическими inline-функциями, которые компилятор встраивает в циклы сборки:
+//
+//   struct MyProblem {
+//       static const char* name() { return "my-problem"; }
+//       static double k(double x);
+//       static double q(double x);
+//       static double f(double x);
+//       static constexpr bool hasAnalyticalSolution = true; // необязательно
+//       static double analytical(double x);                 // только при true
+//   };
+//
+// Постоянные k и q (return 1.0;) сворачиваются компилятором целиком.
+// Политика подключается через SolverModel::setProblem<MyProblem>().
+
+// Тестовая задача: k = 1, q = 0, u = sin(pi x)
+struct SinProblem {
+    static const char* name() { return "sin"; }
+    static constexpr double k(double) { return 1.0; }
+    static constexpr double q(double) { return 0.0; }
+    static double f(double x) { return M_PI * M_PI * std::sin(M_PI * x); }
+    static constexpr bool hasAnalyticalSolution = true;
+    static double analytical(double x) { return vecmath::sinPi(x); } // Векторизуется в циклах по узлам
+};
+
+// Задача с крутым внутренним слоем ширины delta в точке разрыва основной задачи xi = 0.5:
+// u = atan((x - xi) / delta) с линейной поправкой до нулевых граничных условий.
+// Положение слоя фиксировано и не зависит от SolverModel::Params::xi
+struct LayerProblem {
+    static constexpr double xi = 0.5;
+    static constexpr double delta = 1e-3;
+
+    static const char* name() { return "layer"; }
+    static constexpr double k(double) { return 1.0; }
+    static constexpr double q(double) { return 0.0; }
+    static double f(double x) {
+        const double s = (x - xi) / delta;
+        const double t = 1.0 + s * s;
+        return 2.0 * s / (delta * delta * t * t);
+    }
+    static constexpr bool hasAnalyticalSolution = true;
+    static double analytical(double x) {
+        return std::atan((x - xi) / delta) - (1.0 - x) * std::atan(-xi / delta) - x * std::atan((1.0 - xi) / delta);
+    }
+};
+
+// Интерфейс, через который SolverModel работает с политикой. Виртуальный вызов
+// делается один раз на цикл, а не на узел: узлы перебираются внутри PolicyKernels.
+// Узлы равномерной сетки x_i = i * h, i = first, first + step, ..., <= last.
+class ProblemKernels {
+public:
+    virtual ~ProblemKernels() = default;
+
+    virtual const char* name() const = 0;
+    virtual bool hasAnalyticalSolution() const = 0;
+    virtual double analytical(double x) const = 0;
+
+    // Диагонали разностной схемы во внутренних узлах 1..n-1 (граничные строки не трогаются)
+    virtual void assembleMatrix(int n, double* a, double* b, double* c) const = 0;
+    virtual void evaluateRightHandSide(double h, int first, int last, int step, double* f) const = 0;
+    virtual void evaluateAnalytical(double h, int first, int last, int step, double* out) const = 0;
+
+    // Построчная сборка для потоковых режимов: узлы first..first+count-1 сетки
+    // из n разбиений записываются в массивы с нулевого индекса, d = -f.
+    // Граничные строки (узлы 0 и n) заполняет вызывающая сторона
+    virtual void assembleRows(long long n, long long first, int count,
+                              double* a, double* b, double* c, double* d) const = 0;
+    virtual void evaluateAnalyticalRows(long long n, long long first, int count, double* out) const = 0;
+
+    // Неравномерная сетка x_0 < ... < x_n: строки 1..n-1 и правая часть d = -f.
+    // -k u'' аппроксимируется на трёхточечном шаблоне с шагами h_{i-1}, h_i
+    // и средним шагом (h_{i-1} + h_i) / 2; на равномерной сетке совпадает с assembleMatrix
+    virtual void assembleNonUniform(int n, const double* x, double* a, double* b, double* c, double* d) const = 0;
+    virtual void evaluateAnalyticalAt(const double* x, int count, double* out) const = 0;
+
+    // Сборка и прогонка за один проход по сетке из n разбиений с граничными значениями mu1, mu2:
+    // коэффициенты строки i сразу продвигают прямой ход, диагонали и правая часть в память
+    // не пишутся. p и u — массивы из n + 1 элементов; q хранится в u до обратного хода.
+    // Арифметика совпадает со сборкой assembleMatrix и прогонкой по разложению (SolverModel::factorize)
+    virtual void solveFused(int n, double mu1, double mu2, double* p, double* u) const = 0;
+};
+
+namespace detail {
+
+template <typename Problem, typename = void>
+struct HasAnalyticalSolution {
+    static constexpr bool value = false;
+};
+
+template <typename Problem>
+struct HasAnalyticalSolution<Problem, decltype(void(Problem::hasAnalyticalSolution))> {
+    static constexpr bool value = Problem::hasAnalyticalSolution;
+};
+
+} // namespace detail
+
+template <typename Problem>
+class PolicyKernels final : public ProblemKernels {
+public:
+    static constexpr bool hasAnalytical = detail::HasAnalyticalSolution<Problem>::value;
+
+    const char* name() const override { return Problem::name(); }
+    bool hasAnalyticalSolution() const override { return hasAnalytical; }
+
+    double analytical(double x) const override {
+        if constexpr (hasAnalytical) {
+            return Problem::analytical(x);
+        } else {
+            (void)x;
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    void assembleMatrix(int n, double* a, double* b, double* c) const override {
+        const double h = 1.0 / n;
+        for (int i = 1; i < n; ++i) {
+            const double x = i * h;
+            const double k = Problem::k(x);
+            const double q = Problem::q(x);
+
+            a[i] = k / (h * h);                       // Нижняя диагональ
+            b[i] = -2.0 * k / (h * h) - q;           // Центральная диагональ
+            c[i] = k / (h * h);                       // Верхняя диагональ
+        }
+    }
+
+    void evaluateRightHandSide(double h, int first, int last, int step, double* f) const override {
+        for (int i = first; i <= last; i += step) {
+            f[i] = Problem::f(i * h);
+        }
+    }
+
+    void evaluateAnalytical(double h, int first, int last, int step, double* out) const override {
+        for (int i = first; i <= last; i += step) {
+            out[i] = PolicyKernels::analytical(i * h);
+        }
+    }
+
+    void assembleRows(long long n, long long first, int count,
+                      double* a, double* b, double* c, double* d) const override {
+        const double h = 1.0 / n;
+        for (int j = 0; j < count; ++j) {
+            const double x = (first + j) * h;
+            const double k = Problem::k(x);
+            const double q = Problem::q(x);
+
+            a[j] = k / (h * h);
+            b[j] = -2.0 * k / (h * h) - q;
+            c[j] = k / (h * h);
+            d[j] = -Problem::f(x);
+        }
+    }
+
+    void evaluateAnalyticalRows(long long n, long long first, int count, double* out) const override {
+        const double h = 1.0 / n;
+        // Номер узла в double (точно до 2^53): преобразование long long не векторизуется
+        const double base = static_cast<double>(first);
+        for (int j = 0; j < count; ++j) {
+            out[j] = PolicyKernels::analytical((base + j) * h);
+        }
+    }
+
+    void assembleNonUniform(int n, const double* x, double* a, double* b, double* c, double* d) const override {
+        for (int i = 1; i < n; ++i) {
+            const double hLeft = x[i] - x[i - 1];
+            const double hRight = x[i + 1] - x[i];
+            const double hMean = 0.5 * (hLeft + hRight);
+            const double k = Problem::k(x[i]);
+
+            a[i] = k / (hLeft * hMean);
+            c[i] = k / (hRight * hMean);
+            b[i] = -a[i] - c[i] - Problem::q(x[i]);
+            d[i] = -Problem::f(x[i]);
+        }
+    }
+
+    void evaluateAnalyticalAt(const double* x, int count, double* out) const override {
+        for (int i = 0; i < count; ++i) {
+            out[i] = PolicyKernels::analytical(x[i]);
+        }
+    }
+
+    void solveFused(int n, double mu1, double mu2, double* p, double* u) const override {
+        const double h = 1.0 / n;
+
+        // Граничные строки: b = 1, a = c = 0
+        double previousP = 0.0;
+        double previousQ = mu1;
+        p[0] = previousP;
+        u[0] = previousQ;
+
+        for (int i = 1; i < n; ++i) {
+            const double x = i * h;
+            const double k = Problem::k(x);
+            const double a = k / (h * h);
+            const double b = -2.0 * k / (h * h) - Problem::q(x);
+            const double c = k / (h * h);
+            const double d = -Problem::f(x);
+
+            const double denom = b + a * previousP;
+            if (std::fabs(denom) < 1e-12) { // Проверка на деление на ноль
+                throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+            }
+            previousP = -c / denom;
+            previousQ = (d - a * previousQ) * (1.0 / denom);
+            p[i] = previousP;
+            u[i] = previousQ;
+        }
+        p[n] = 0.0;
+        u[n] = mu2;
+
+        // Обратный ход
+        for (int i = n - 1; i >= 0; --i) {
+            u[i] = p[i] * u[i + 1] + u[i];
+        }
+    }
+};
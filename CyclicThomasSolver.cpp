@@ -0,0 +1,73 @@
+#include "CyclicThomasSolver.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+void checkPivot(double denom) {
+    if (std::fabs(denom) < 1e-12) { // Проверка на деление на ноль
+        throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+    }
+}
+
+} // namespace
+
+void CyclicThomasSolver::solve(const std::vector<double>& a,
+                               const std::vector<double>& b,
+                               const std::vector<double>& c,
+                               const std::vector<double>& d,
+                               std::vector<double>& u) {
+    const size_t n = b.size();
+    if (n < 3 || a.size() != n || c.size() != n || d.size() != n) {
+        throw std::invalid_argument("Размеры диагоналей и правой части не совпадают или меньше 3");
+    }
+    if (&u == &d) {
+        throw std::invalid_argument("Решение не может записываться в правую часть");
+    }
+
+    // A = A' + w v^T, w = (gamma, 0, ..., 0, c[n-1]), v = (1, 0, ..., 0, a[0] / gamma);
+    // у A' угловые элементы нулевые, а b[0] и b[n-1] уменьшены на gamma и a[0] c[n-1] / gamma
+    const double gamma = -b[0];
+    const double corner = a[0] / gamma;
+    m_p.resize(n);
+    m_invDenom.resize(n);
+    m_z.resize(n);
+    u.resize(n);
+
+    // Прямой ход сразу для двух правых частей: d (в u) и w (в m_z)
+    double denom = b[0] - gamma;
+    checkPivot(denom);
+    m_invDenom[0] = 1.0 / denom;
+    m_p[0] = -c[0] / denom;
+    u[0] = d[0] * m_invDenom[0];
+    m_z[0] = gamma * m_invDenom[0];
+    for (size_t i = 1; i + 1 < n; ++i) {
+        denom = b[i] + a[i] * m_p[i - 1];
+        checkPivot(denom);
+        m_invDenom[i] = 1.0 / denom;
+        m_p[i] = -c[i] / denom;
+        u[i] = (d[i] - a[i] * u[i - 1]) * m_invDenom[i];
+        m_z[i] = -a[i] * m_z[i - 1] * m_invDenom[i];
+    }
+    const size_t last = n - 1;
+    denom = b[last] - c[last] * corner + a[last] * m_p[last - 1];
+    checkPivot(denom);
+    m_invDenom[last] = 1.0 / denom;
+    m_p[last] = 0.0;
+    u[last] = (d[last] - a[last] * u[last - 1]) * m_invDenom[last];
+    m_z[last] = (c[last] - a[last] * m_z[last - 1]) * m_invDenom[last];
+
+    // Обратный ход
+    for (size_t i = last; i-- > 0;) {
+        u[i] = m_p[i] * u[i + 1] + u[i];
+        m_z[i] = m_p[i] * m_z[i + 1] + m_z[i];
+    }
+
+    // u = y - z (v^T y) / (1 + v^T z)
+    const double denominator = 1.0 + m_z[0] + corner * m_z[last];
+    checkPivot(denominator);
+    const double factor = (u[0] + corner * u[last]) / denominator;
+    for (size_t i = 0; i < n; ++i) {
+        u[i] -= factor * m_z[i];
+    }
+}
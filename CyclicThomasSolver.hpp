@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+// Прогонка для циклической (периодической) трёхдиагональной системы:
+// строка i связывает u_{i-1}, u_i, u_{i+1}, индексы по модулю n, т. е.
+// a[0] — коэффициент при u_{n-1} в первой строке, c[n-1] — при u_0 в последней.
+// Формула Шермана — Моррисона сводит систему к обычной трёхдиагональной
+// с изменёнными b[0], b[n-1] и двумя правыми частями, которые решаются
+// одной прогонкой по общему разложению; сложность O(n).
+class CyclicThomasSolver {
+public:
+    // n >= 3; u не может совпадать с d
+    void solve(const std::vector<double>& a,
+               const std::vector<double>& b,
+               const std::vector<double>& c,
+               const std::vector<double>& d,
+               std::vector<double>& u);
+
+private:
+    std::vector<double> m_p;        // Прогоночные коэффициенты изменённой матрицы
+    std::vector<double> m_invDenom; // Обратные знаменатели прямого хода
+    std::vector<double> m_z;        // Решение для поправки ранга 1
+};
@@ -0,0 +1,120 @@
+#include "ErrorNorms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Блок узлов: значения, ошибки и веса блока (6 КБ) остаются в L1
+const size_t kBlock = 256;
+// Независимые накопители редукции: без -ffast-math компилятор
+// векторизует сумму и максимум только в такой форме
+const size_t kLanes = 4;
+
+// Веса квадратурной формулы трапеций для узлов first .. first + count - 1
+void trapezoidWeights(const GridView& x, size_t first, size_t count, double* weights) {
+    const size_t last = x.size() - 1;
+    if (x.isUniform()) {
+        const double h = x[1] - x[0];
+        std::fill(weights, weights + count, h);
+    } else {
+        const double* nodes = x.nodes().data();
+        for (size_t j = 0; j < count; ++j) {
+            const size_t i = first + j;
+            weights[j] = 0.5 * (nodes[std::min(i + 1, last)] - nodes[i == 0 ? 0 : i - 1]);
+        }
+    }
+    if (x.isUniform() && first == 0) {
+        weights[0] *= 0.5;
+    }
+    if (x.isUniform() && first + count == last + 1) {
+        weights[count - 1] *= 0.5;
+    }
+}
+
+} // namespace
+
+ErrorNorms computeErrorNorms(const GridView& x, const std::vector<double>& u,
+                             const AnalyticalView& analytical, const std::vector<double>* coarse) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const size_t size = u.size();
+    ErrorNorms norms;
+
+    // Грубая сетка вложена, если её узлы совпадают с чётными узлами текущей
+    const bool nested = coarse && size % 2 == 1 && coarse->size() == size / 2 + 1;
+    if (nested) {
+        double gridError = 0.0;
+        const double* coarseU = coarse->data();
+        for (size_t i = 0; i < coarse->size(); ++i) {
+            const double difference = std::fabs(coarseU[i] - u[2 * i]);
+            gridError = difference > gridError ? difference : gridError;
+        }
+        norms.gridError = gridError;
+    } else {
+        norms.gridError = nan;
+    }
+
+    if (size < 2 || analytical.size() != size || x.size() != size) {
+        norms.maxError = norms.l2Error = norms.relativeError = nan;
+        return norms;
+    }
+
+    double values[kBlock];
+    double errors[kBlock];
+    double weights[kBlock];
+    double sumLanes[kLanes] = {};
+    double normLanes[kLanes] = {};
+
+    for (size_t first = 0; first < size; first += kBlock) {
+        const size_t count = std::min(kBlock, size - first);
+        analytical.evaluate(first, count, values);
+        trapezoidWeights(x, first, count, weights);
+
+        const double* block = u.data() + first;
+        for (size_t j = 0; j < count; ++j) {
+            errors[j] = block[j] - values[j];
+        }
+
+        // Максимум блока считается отдельно: номер узла ищется, только если он растёт
+        double blockLanes[kLanes] = {};
+        size_t j = 0;
+        for (; j + kLanes <= count; j += kLanes) {
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                const double error = errors[j + lane];
+                const double absError = std::fabs(error);
+                const double absValue = std::fabs(values[j + lane]);
+                blockLanes[lane] = absError > blockLanes[lane] ? absError : blockLanes[lane];
+                normLanes[lane] = absValue > normLanes[lane] ? absValue : normLanes[lane];
+                sumLanes[lane] += weights[j + lane] * error * error;
+            }
+        }
+        for (; j < count; ++j) {
+            const double absError = std::fabs(errors[j]);
+            const double absValue = std::fabs(values[j]);
+            blockLanes[0] = absError > blockLanes[0] ? absError : blockLanes[0];
+            normLanes[0] = absValue > normLanes[0] ? absValue : normLanes[0];
+            sumLanes[0] += weights[j] * errors[j] * errors[j];
+        }
+
+        const double blockMax = *std::max_element(blockLanes, blockLanes + kLanes);
+        if (blockMax > norms.maxError) {
+            norms.maxError = blockMax;
+            for (size_t k = 0; k < count; ++k) {
+                if (std::fabs(errors[k]) == blockMax) {
+                    norms.maxIndex = first + k;
+                    break;
+                }
+            }
+        }
+    }
+
+    double sum = 0.0;
+    double valueNorm = 0.0;
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        sum += sumLanes[lane];
+        valueNorm = std::max(valueNorm, normLanes[lane]);
+    }
+    norms.l2Error = std::sqrt(sum);
+    norms.relativeError = valueNorm > 0.0 ? norms.maxError / valueNorm : nan;
+    return norms;
+}
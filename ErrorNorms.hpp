@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "ResultViews.hpp"
+
+// Нормы ошибки численного решения, вычисленные за один проход по узлам
+struct ErrorNorms {
+    double maxError = 0.0;   // max |u - v|
+    size_t maxIndex = 0;     // Узел, в котором достигается maxError
+    double l2Error = 0.0;    // ||u - v|| в L2(0, 1), квадратурная формула трапеций
+    double relativeError = 0.0; // maxError / max |v|
+    double gridError = 0.0;  // max |u_coarse[i] - u[2i]|; NaN без вложенной грубой сетки
+};
+
+// Аналитическое решение вычисляется блоками, которые помещаются в L1, и в том же
+// блоке накапливаются все нормы. coarse — решение на вдвое более грубой сетке
+// (узлы x_{2i}) или nullptr. Без аналитического решения нормы относительно v равны NaN
+ErrorNorms computeErrorNorms(const GridView& x, const std::vector<double>& u,
+                             const AnalyticalView& analytical, const std::vector<double>* coarse = nullptr);
@@ -1,17 +1,24 @@
 #include "MainTaskWidget.hpp"
+#include "ChartDecimation.hpp"
+#include "ResultFile.hpp"
+#include <QFile>
+#include <QFileDialog>
 #include <QLabel>
+#include <QCheckBox>
 #include <QtCharts/QChart>
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QLogValueAxis>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMessageBox>
-#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace QtCharts;
 
 MainTaskWidget::MainTaskWidget(QWidget* parent)
-    : QWidget(parent), m_model(nullptr) {
+    : QWidget(parent), m_model(nullptr), m_runner(new SolverRunner(this)) {
     setupUI();
 }
 
@@ -34,7 +41,17 @@ void MainTaskWidget::setupUI()
     m_infoText = new QTextEdit(this);
     m_infoText->setReadOnly(true);
 
+    m_adaptiveCheckBox = new QCheckBox("Adaptive mesh", this);
+    m_adaptiveCheckBox->setToolTip("Сгущать сетку только там, где велика оценка ошибки (около xi)");
+
     m_solveButton = new QPushButton("Solve", this);
+    m_cancelButton = new QPushButton("Cancel", this);
+    m_cancelButton->setEnabled(false);
+    m_saveButton = new QPushButton("Save...", this);
+    m_saveButton->setToolTip("Сохранить результат в двоичный файл (*.res, массивы в формате NumPy .npy)");
+    m_saveButton->setEnabled(false);
+    m_loadButton = new QPushButton("Load...", this);
+    m_loadButton->setToolTip("Показать результат, сохранённый ранее");
 
     // Создание вкладок для результатов
     m_resultsTabWidget = new QTabWidget(this);
@@ -43,8 +60,10 @@ void MainTaskWidget::setupUI()
     QWidget* tablesTab = new QWidget();
     QVBoxLayout* tablesLayout = new QVBoxLayout(tablesTab);
 
-    m_resultsTable = new QTableWidget(this);
-    m_refinedResultsTable = new QTableWidget(this);
+    m_resultsTableModel = new ResultTableModel(ResultTableModel::Layout::Solution, this);
+    m_refinedResultsTableModel = new ResultTableModel(ResultTableModel::Layout::GridComparison, this);
+    m_resultsTable = createResultTableView(m_resultsTableModel, this);
+    m_refinedResultsTable = createResultTableView(m_refinedResultsTableModel, this);
 
     tablesLayout->addWidget(new QLabel("Main Results:"));
     tablesLayout->addWidget(m_resultsTable);
@@ -79,6 +98,7 @@ void MainTaskWidget::setupUI()
     QVBoxLayout* logErrorPlotLayout = new QVBoxLayout(logErrorPlotTab);
     m_logErrorPlot = new QChartView(new QChart(), this);
     logErrorPlotLayout->addWidget(m_logErrorPlot);
+    setupCharts();
     logErrorPlotTab->setLayout(logErrorPlotLayout);
 
     // Добавление под-вкладок
@@ -101,7 +121,11 @@ void MainTaskWidget::setupUI()
     inputLayout->addWidget(m_spinBoxN);
     inputLayout->addWidget(new QLabel("Accuracy (epsilon):"));
     inputLayout->addWidget(m_spinBoxEpsilon);
+    inputLayout->addWidget(m_adaptiveCheckBox);
     inputLayout->addWidget(m_solveButton);
+    inputLayout->addWidget(m_cancelButton);
+    inputLayout->addWidget(m_saveButton);
+    inputLayout->addWidget(m_loadButton);
 
     mainLayout->addLayout(inputLayout);
     mainLayout->addWidget(m_infoText);
@@ -111,6 +135,22 @@ void MainTaskWidget::setupUI()
 
     // Подключение сигналов и слотов
     connect(m_solveButton, &QPushButton::clicked, this, &MainTaskWidget::onSolveButtonClicked);
+    connect(m_cancelButton, &QPushButton::clicked, m_runner, &SolverRunner::cancel);
+    connect(m_saveButton, &QPushButton::clicked, this, &MainTaskWidget::onSaveButtonClicked);
+    connect(m_loadButton, &QPushButton::clicked, this, &MainTaskWidget::onLoadButtonClicked);
+    connect(m_runner, &SolverRunner::progress, this, &MainTaskWidget::onSolveProgress);
+    connect(m_runner, &SolverRunner::finished, this, &MainTaskWidget::onSolveFinished);
+    connect(m_runner, &SolverRunner::failed, this, &MainTaskWidget::onSolveFailed);
+}
+
+void MainTaskWidget::setRunning(bool running) {
+    m_solveButton->setEnabled(!running);
+    m_cancelButton->setEnabled(running);
+    m_spinBoxN->setEnabled(!running);
+    m_spinBoxEpsilon->setEnabled(!running);
+    m_adaptiveCheckBox->setEnabled(!running);
+    m_saveButton->setEnabled(!running && m_lastResult);
+    m_loadButton->setEnabled(!running);
 }
 
 void MainTaskWidget::onSolveButtonClicked() {
@@ -126,179 +166,214 @@ void MainTaskWidget::onSolveButtonClicked() {
 
     try {
         m_model->setParams(params);
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
+        return;
+    }
 
-        // Выполнение решения с уточнением
-        SolverModel::Result result;
-        SolverModel::Result refinedResult;
+    // Сгущение выполняется в фоне на копии модели
+    m_lastParams = params;
+    m_infoText->clear();
+    setRunning(true);
+    if (m_adaptiveCheckBox->isChecked()) {
+        m_runner->startSolveAdaptive(*m_model, params.epsilon);
+    } else {
+        m_runner->startSolveWithAccuracy(*m_model, params.epsilon);
+    }
+}
 
-        result = m_model->solveWithAccuracy(params.epsilon);
+void MainTaskWidget::onSolveProgress(int iteration, int n, double maxError, double elapsed) {
+    m_infoText->append(QString("Уровень %1: n = %2, ошибка = %3, %4 с")
+                           .arg(iteration).arg(n).arg(maxError).arg(elapsed, 0, 'f', 3));
+}
 
-        // Правильное присвоение уточнённых результатов
-        refinedResult.x = result.x;
-        refinedResult.u = result.uRefined;
-        refinedResult.analytical = result.analytical;
-        refinedResult.maxError = result.maxErrorRefined;
+void MainTaskWidget::onSolveFinished(std::shared_ptr<const SolverModel::Result> result) {
+    m_lastResult = result;
+    setRunning(false);
 
+    try {
         // Отображение результатов
-        displayResults(result, refinedResult);
+        PhaseTimings displayTimings;
+        {
+            SOLVER_PROFILE_PHASE(displayTimings, SolverPhase::Display);
+            displayResults(result);
+        }
+        m_infoText->append(QString("Отображение результатов: %1 мс")
+                               .arg(displayTimings[SolverPhase::Display] * 1e3, 0, 'f', 3));
+        if (result->cancelled) {
+            m_infoText->append("Решение прервано: показан последний решённый уровень.");
+        }
     }
     catch (const std::exception& e) {
         QMessageBox::critical(this, "Ошибка", e.what());
     }
 }
 
-void MainTaskWidget::displayResults(const SolverModel::Result& result, const SolverModel::Result& refinedResult) {
-    // Справка
-    QString info;
-    info += QString("Количество разбиений (n): %1\n").arg(result.x.size() - 1);
-    info += QString("Максимальная ошибка (ε1): %1\n").arg(result.maxError);
+void MainTaskWidget::onSolveFailed(const QString& message) {
+    setRunning(false);
+    QMessageBox::critical(this, "Ошибка", message);
+}
 
-    if (!refinedResult.x.empty()) {
-        double maxError = m_model->calculateGridError(result, refinedResult);
-        info += QString("Максимальная ошибка на уточнённой сетке (ε2): %1\n").arg(maxError);
-    }
+void MainTaskWidget::onSaveButtonClicked() {
+    if (!m_lastResult || !m_model) return;
 
-    m_infoText->setText(info);
+    const QString path = QFileDialog::getSaveFileName(this, "Сохранить результат", QString(),
+                                                      "Результаты (*.res)");
+    if (path.isEmpty()) return;
 
-    // Таблица основных результатов
-    m_resultsTable->clear();
-    m_resultsTable->setRowCount(result.x.size());
-    m_resultsTable->setColumnCount(4);
-    m_resultsTable->setHorizontalHeaderLabels({"x_i", "u(x_i)", "v(x_i)", "u(x_i) - v(x_i)"});
-
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        m_resultsTable->setItem(i, 0, new QTableWidgetItem(QString::number(result.x[i])));
-        m_resultsTable->setItem(i, 1, new QTableWidgetItem(QString::number(result.u[i])));
-        m_resultsTable->setItem(i, 2, new QTableWidgetItem(QString::number(result.analytical[i])));
-        m_resultsTable->setItem(i, 3, new QTableWidgetItem(QString::number(result.u[i] - result.analytical[i])));
+    try {
+        writeResultFile(QFile::encodeName(path).toStdString(), m_lastParams, *m_lastResult,
+                        m_model->problem().name());
+        m_infoText->append(QString("Результат сохранён: %1").arg(path));
     }
-    m_resultsTable->resizeColumnsToContents();
-
-    // Таблица для уточнённых результатов
-    if (!refinedResult.u.empty()) {
-        m_refinedResultsTable->clear();
-        int refinedSize = refinedResult.x.size();
-        int displaySize = refinedSize / 2 + 1;
-        m_refinedResultsTable->setRowCount(displaySize);
-        m_refinedResultsTable->setColumnCount(4);
-        m_refinedResultsTable->setHorizontalHeaderLabels({"x_{2i}", "u2(x_{2i})", "v2(x_{2i})", "u2 - v2"});
-
-        for (size_t i = 0; i < displaySize; ++i) {
-            int idx = 2 * i;
-            if (idx >= refinedSize) idx = refinedSize - 1; // Последний индекс
-            m_refinedResultsTable->setItem(i, 0, new QTableWidgetItem(QString::number(refinedResult.x[idx])));
-            m_refinedResultsTable->setItem(i, 1, new QTableWidgetItem(QString::number(refinedResult.u[idx])));
-            m_refinedResultsTable->setItem(i, 2, new QTableWidgetItem(QString::number(refinedResult.analytical[idx])));
-            m_refinedResultsTable->setItem(i, 3, new QTableWidgetItem(QString::number(refinedResult.u[idx] - refinedResult.analytical[idx])));
-        }
-        m_refinedResultsTable->resizeColumnsToContents();
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
     }
+}
 
-    // График решений
-    QChart* chart = new QChart();
-    QLineSeries* numericalSeries = new QLineSeries();
-    QLineSeries* analyticalSeries = new QLineSeries();
+void MainTaskWidget::onLoadButtonClicked() {
+    const QString path = QFileDialog::getOpenFileName(this, "Открыть результат", QString(),
+                                                      "Результаты (*.res)");
+    if (path.isEmpty()) return;
 
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        numericalSeries->append(result.x[i], result.u[i]);
-        analyticalSeries->append(result.x[i], result.analytical[i]);
+    try {
+        // Массивы, кроме u, читаются из отображённого в память файла без копирования
+        SolverModel::Params params;
+        std::shared_ptr<const SolverModel::Result> result =
+            loadResultFile(QFile::encodeName(path).toStdString(), &params);
+        m_spinBoxN->setValue(params.n);
+        m_spinBoxEpsilon->setValue(params.epsilon);
+        m_lastParams = params;
+        m_lastResult = result;
+        displayResults(result);
+        m_infoText->append(QString("Загружено из файла: %1").arg(path));
+        setRunning(false);
     }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
+    }
+}
 
-    chart->addSeries(numericalSeries);
-    chart->addSeries(analyticalSeries);
-    chart->setTitle("Решения");
-    chart->createDefaultAxes();
-
-    numericalSeries->setName("Численное решение");
-    analyticalSeries->setName("Аналитическое решение");
+void MainTaskWidget::displayResults(const std::shared_ptr<const SolverModel::Result>& resultPtr) {
+    const SolverModel::Result& result = *resultPtr;
 
-    m_plot->setChart(chart);
+    // Справка
+    QString info;
+    info += QString("Количество разбиений (n): %1\n").arg(result.x.size() - 1);
+    info += QString("Максимальная ошибка (ε1): %1\n").arg(result.maxError);
 
-    // График ошибки
-    QChart* errorChart = new QChart();
-    QLineSeries* errorSeries = new QLineSeries();
+    if (!std::isnan(result.norms.l2Error)) {
+        info += QString("Норма ошибки в L2: %1, относительная ошибка: %2\n")
+                    .arg(result.norms.l2Error).arg(result.norms.relativeError);
+    }
 
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        errorSeries->append(result.x[i], std::abs(result.u[i] - result.analytical[i]));
+    // Расхождение с предыдущим уровнем в общих узлах u_prev[i] и u[2i]; считается при решении уровня
+    if (!std::isnan(result.norms.gridError)) {
+        info += QString("Максимальная ошибка на уточнённой сетке (ε2): %1\n").arg(result.norms.gridError);
     }
 
-    errorChart->addSeries(errorSeries);
-    errorChart->setTitle("Ошибка между решениями");
-    errorChart->createDefaultAxes();
+    // Время по фазам: последний уровень и сумма по всем уровням сгущения
+    info += "\nВремя по фазам (последний уровень):\n";
+    info += QString::fromStdString(timingsSummary(result.timings));
+    if (result.timingData.size() > 1) {
+        info += QString("Время по фазам (все %1 уровней):\n").arg(result.timingData.size());
+        info += QString::fromStdString(timingsSummary(sumTimings(result.timingData)));
+    }
 
-    errorSeries->setName("Ошибка");
+    m_infoText->setText(info);
 
-    m_errorPlot->setChart(errorChart);
+    // Таблицы читают результат напрямую, строки форматируются при отрисовке
+    m_resultsTableModel->setResult(resultPtr);
+    m_refinedResultsTableModel->setResult(resultPtr);
 
-    // График ошибки vs n (логарифмический)
-    if (!result.convergenceData.empty()) {
-        // Отладочные сообщения
-        qDebug() << "Convergence Data Size:" << result.convergenceData.size();
-        for (const auto& data : result.convergenceData) {
-            qDebug() << "n:" << data.n << ", error:" << data.error;
-        }
+    // Графики: ряды прорежены до ширины области построения и заменяются целиком
+    const int pixelWidth = chartPixelWidth(m_plot);
+    const bool hasAnalytical = result.analytical.size() == result.x.size();
+    // Аналитическое решение вычисляется векторизованно небольшими блоками
+    BlockValues<AnalyticalView> analytical(result.analytical);
 
-        // Создаём логарифмические оси
-        QLogValueAxis* axisX = new QLogValueAxis;
-        axisX->setTitleText("Количество разбиений (n)");
-        axisX->setBase(10);
-        axisX->setMinorTickCount(4);
-        axisX->setLabelFormat("%.0f"); // Целые числа для n
+    m_numericalSeries->replace(decimateMinMax(result.x, [&](size_t i) { return result.u[i]; }, pixelWidth));
+    m_analyticalSeries->replace(hasAnalytical
+        ? decimateMinMax(result.x, [&](size_t i) { return analytical(i); }, pixelWidth)
+        : QVector<QPointF>());
+    fitAxesToSeries(m_plot->chart());
 
-        QLogValueAxis* axisY = new QLogValueAxis;
-        axisY->setTitleText("Ошибка");
-        axisY->setBase(10);
-        axisY->setMinorTickCount(4);
-        axisY->setLabelFormat("%.2e"); // Научная нотация для ошибок
+    // График ошибки
+    m_errorSeries->replace(hasAnalytical
+        ? decimateMinMax(result.x, [&](size_t i) { return std::abs(result.u[i] - analytical(i)); },
+                         chartPixelWidth(m_errorPlot))
+        : QVector<QPointF>());
+    fitAxesToSeries(m_errorPlot->chart());
 
+    // График ошибки vs n (логарифмический)
+    if (!result.convergenceData.empty()) {
         // Определение диапазона осей
         double minN = std::numeric_limits<double>::max();
         double maxN = std::numeric_limits<double>::min();
         double minError = std::numeric_limits<double>::max();
         double maxError = std::numeric_limits<double>::min();
 
+        QVector<QPointF> points;
+        points.reserve(static_cast<int>(result.convergenceData.size()));
         for (const auto& data : result.convergenceData) {
             if (data.n < minN) minN = data.n;
             if (data.n > maxN) maxN = data.n;
             if (data.error < minError) minError = data.error;
             if (data.error > maxError) maxError = data.error;
+            points.append(QPointF(data.n, data.error));
         }
 
         // Проверка, что минимальные значения не равны бесконечности
         if (minN == std::numeric_limits<double>::max()) minN = 1;
         if (minError == std::numeric_limits<double>::max()) minError = 1e-12;
 
-        // Установка диапазона осей
-        axisX->setRange(minN, maxN);
-        axisY->setRange(minError, maxError);
-
-        // Создаём график и серию
-        QChart* logErrorChart = new QChart();
-        QLineSeries* logErrorSeries = new QLineSeries();
-
-        for (const auto& data : result.convergenceData) {
-            logErrorSeries->append(data.n, data.error);
-        }
-
-        logErrorChart->addSeries(logErrorSeries);
-        logErrorChart->setTitle("Ошибка vs Количество разбиений (n)");
-
-        // Добавляем оси к графику
-        logErrorChart->addAxis(axisX, Qt::AlignBottom);
-        logErrorChart->addAxis(axisY, Qt::AlignLeft);
-
-        // Привязываем серию к осям
-        logErrorSeries->attachAxis(axisX);
-        logErrorSeries->attachAxis(axisY);
-
-        logErrorSeries->setName("Ошибка");
+        m_logErrorSeries->replace(points);
+        m_logAxisX->setRange(minN, maxN);
+        m_logAxisY->setRange(minError, maxError);
+    }
+}
 
-        logErrorChart->legend()->hide();
+void MainTaskWidget::setupCharts() {
+    // Ряды и оси создаются один раз и переиспользуются между решениями
+    QChart* chart = m_plot->chart();
+    m_numericalSeries = new QLineSeries();
+    m_analyticalSeries = new QLineSeries();
+    m_numericalSeries->setName("Численное решение");
+    m_analyticalSeries->setName("Аналитическое решение");
+    chart->addSeries(m_numericalSeries);
+    chart->addSeries(m_analyticalSeries);
+    chart->setTitle("Решения");
+    chart->createDefaultAxes();
 
-        m_logErrorPlot->setChart(logErrorChart);
+    QChart* errorChart = m_errorPlot->chart();
+    m_errorSeries = new QLineSeries();
+    m_errorSeries->setName("Ошибка");
+    errorChart->addSeries(m_errorSeries);
+    errorChart->setTitle("Ошибка между решениями");
+    errorChart->createDefaultAxes();
 
-        // Обновление графика
-        m_logErrorPlot->update();
-    }
+    // Логарифмические оси
+    m_logAxisX = new QLogValueAxis;
+    m_logAxisX->setTitleText("Количество разбиений (n)");
+    m_logAxisX->setBase(10);
+    m_logAxisX->setMinorTickCount(4);
+    m_logAxisX->setLabelFormat("%.0f"); // Целые числа для n
+
+    m_logAxisY = new QLogValueAxis;
+    m_logAxisY->setTitleText("Ошибка");
+    m_logAxisY->setBase(10);
+    m_logAxisY->setMinorTickCount(4);
+    m_logAxisY->setLabelFormat("%.2e"); // Научная нотация для ошибок
+
+    QChart* logErrorChart = m_logErrorPlot->chart();
+    m_logErrorSeries = new QLineSeries();
+    m_logErrorSeries->setName("Ошибка");
+    logErrorChart->addSeries(m_logErrorSeries);
+    logErrorChart->setTitle("Ошибка vs Количество разбиений (n)");
+    logErrorChart->addAxis(m_logAxisX, Qt::AlignBottom);
+    logErrorChart->addAxis(m_logAxisY, Qt::AlignLeft);
+    m_logErrorSeries->attachAxis(m_logAxisX);
+    m_logErrorSeries->attachAxis(m_logAxisY);
+    logErrorChart->legend()->hide();
 }
-
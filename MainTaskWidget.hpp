@@ -5,11 +5,16 @@
 #include <QSpinBox>
 #include <QDoubleSpinBox>
 #include <QPushButton>
+#include <QCheckBox>
 #include <QTextEdit>
-#include <QTableWidget>
+#include <QTableView>
 #include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QLogValueAxis>
 #include <QTabWidget>
+#include "ResultTableModel.hpp"
 #include "SolverModel.hpp"
+#include "SolverRunner.hpp"
 
 class MainTaskWidget : public QWidget {
     Q_OBJECT
@@ -20,30 +25,54 @@ public:
 
 private slots:
     void onSolveButtonClicked();
+    void onSolveProgress(int iteration, int n, double maxError, double elapsed);
+    void onSolveFinished(std::shared_ptr<const SolverModel::Result> result);
+    void onSolveFailed(const QString& message);
+    void onSaveButtonClicked();
+    void onLoadButtonClicked();
 
 private:
     void setupUI();
-    void displayResults(const SolverModel::Result& result, const SolverModel::Result& refinedResult);
+    void setupCharts();
+    void displayResults(const std::shared_ptr<const SolverModel::Result>& result);
+    void setRunning(bool running);
 
     SolverModel* m_model;
+    SolverRunner* m_runner;
 
     // Элементы управления
     QSpinBox* m_spinBoxN;
     QDoubleSpinBox* m_spinBoxEpsilon;
     QTextEdit* m_infoText;
+    QCheckBox* m_adaptiveCheckBox;
     QPushButton* m_solveButton;
+    QPushButton* m_cancelButton;
+    QPushButton* m_saveButton;
+    QPushButton* m_loadButton;
+
+    // Показанный результат и его параметры: сохраняются в файл результата (ResultFile.hpp)
+    std::shared_ptr<const SolverModel::Result> m_lastResult;
+    SolverModel::Params m_lastParams{0.0, 0.0, 0.5, 10, 1e-6};
 
     // Вкладки для отображения результатов
     QTabWidget* m_resultsTabWidget;
 
     // Таблицы
-    QTableWidget* m_resultsTable;
-    QTableWidget* m_refinedResultsTable;
+    QTableView* m_resultsTable;
+    QTableView* m_refinedResultsTable;
+    ResultTableModel* m_resultsTableModel;
+    ResultTableModel* m_refinedResultsTableModel;
 
     // Графики
     QtCharts::QChartView* m_plot;
     QtCharts::QChartView* m_errorPlot;
     QtCharts::QChartView* m_logErrorPlot;
+    QtCharts::QLineSeries* m_numericalSeries;
+    QtCharts::QLineSeries* m_analyticalSeries;
+    QtCharts::QLineSeries* m_errorSeries;
+    QtCharts::QLineSeries* m_logErrorSeries;
+    QtCharts::QLogValueAxis* m_logAxisX;
+    QtCharts::QLogValueAxis* m_logAxisY;
 };
 
 #endif // MAINTASKWIDGET_HPP
@@ -0,0 +1,197 @@
+#include "MixedPrecisionSolver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const double kZeroPivot = 1e-12;
+
+// Поправка считается пренебрежимой относительно решения
+const double kConvergedCorrection = 1e-12;
+// Наибольшая поправка на последнем шаге, при которой решение принимается
+const double kAcceptedCorrection = 1e-10;
+// Наибольшее cond(A) * eps_float, при котором уточнение ещё сходится за 3 шага
+// (для -u'' до n ~ 2000)
+const double kMaxConditionFloat = 0.25;
+
+void checkPivot(double denom) {
+    if (std::fabs(denom) < kZeroPivot) { // Проверка на деление на ноль
+        throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+    }
+}
+
+double maxNorm(const std::vector<double>& v) {
+    double norm = 0.0;
+    for (double value : v) {
+        norm = std::max(norm, std::fabs(value));
+    }
+    return norm;
+}
+
+} // namespace
+
+MixedPrecisionSolver::MixedPrecisionSolver(int maxRefinements) {
+    setMaxRefinements(maxRefinements);
+}
+
+void MixedPrecisionSolver::setMaxRefinements(int maxRefinements) {
+    if (maxRefinements < 0) {
+        throw std::invalid_argument("Число шагов уточнения не может быть отрицательным");
+    }
+    m_maxRefinements = maxRefinements;
+}
+
+double MixedPrecisionSolver::conditionEstimate(const std::vector<double>& a,
+                                              const std::vector<double>& b,
+                                              const std::vector<double>& c) {
+    const size_t size = b.size();
+    const double infinity = std::numeric_limits<double>::infinity();
+    double norm = 0.0;
+    double minDominance = infinity;
+    double minCoupling = infinity;
+    double maxCoupling = 0.0;
+    auto addRow = [&](double diagonal, double coupling) {
+        norm = std::max(norm, diagonal + coupling);
+        minDominance = std::min(minDominance, diagonal - coupling);
+        minCoupling = std::min(minCoupling, coupling > 0.0 ? coupling : infinity);
+        maxCoupling = std::max(maxCoupling, coupling);
+    };
+    // Первая и последняя строки связаны только с одним соседом; цикл без ветвлений векторизуется
+    addRow(std::fabs(b[0]), std::fabs(c[0]));
+    for (size_t i = 1; i + 1 < size; ++i) {
+        addRow(std::fabs(b[i]), std::fabs(a[i]) + std::fabs(c[i]));
+    }
+    addRow(std::fabs(b[size - 1]), std::fabs(a[size - 1]));
+
+    if (maxCoupling == 0.0) {
+        return minDominance > 0.0 ? norm / minDominance : infinity;
+    }
+    const double n = static_cast<double>(size);
+    const double operatorEstimate = 4.0 / (M_PI * M_PI) * n * n * (maxCoupling / minCoupling);
+    return minDominance > 0.0 ? std::min(operatorEstimate, norm / minDominance) : operatorEstimate;
+}
+
+void MixedPrecisionSolver::factorize(const std::vector<double>& a, const std::vector<double>& b,
+                                     const std::vector<double>& c) {
+    const size_t size = b.size();
+    m_a.resize(size);
+    m_p.resize(size);
+    m_invDenom.resize(size);
+    m_q.resize(size);
+
+    checkPivot(b[0]);
+    m_a[0] = 0.0f;
+    m_invDenom[0] = 1.0f / static_cast<float>(b[0]);
+    m_p[0] = -static_cast<float>(c[0]) / static_cast<float>(b[0]);
+    for (size_t i = 1; i < size; ++i) {
+        const float ai = static_cast<float>(a[i]);
+        const float denom = static_cast<float>(b[i]) + ai * m_p[i - 1];
+        checkPivot(denom);
+        m_a[i] = ai;
+        m_p[i] = -static_cast<float>(c[i]) / denom;
+        m_invDenom[i] = 1.0f / denom;
+    }
+}
+
+void MixedPrecisionSolver::sweep(const double* rhs, double* x) {
+    const size_t size = m_p.size();
+    float q = static_cast<float>(rhs[0]) * m_invDenom[0];
+    m_q[0] = q;
+    for (size_t i = 1; i < size; ++i) {
+        q = (static_cast<float>(rhs[i]) - m_a[i] * q) * m_invDenom[i];
+        m_q[i] = q;
+    }
+
+    float next = m_q[size - 1];
+    x[size - 1] = next;
+    for (size_t i = size - 1; i-- > 0;) {
+        next = m_p[i] * next + m_q[i];
+        x[i] = next;
+    }
+}
+
+void MixedPrecisionSolver::solve(const std::vector<double>& a,
+                                 const std::vector<double>& b,
+                                 const std::vector<double>& c,
+                                 const std::vector<double>& d,
+                                 std::vector<double>& u) {
+    const size_t size = b.size();
+    if (size < 2 || a.size() != size || c.size() != size || d.size() != size) {
+        throw std::invalid_argument("Размеры диагоналей и правой части не совпадают");
+    }
+    if (&u == &d) {
+        throw std::invalid_argument("Решение не может записываться в правую часть");
+    }
+
+    m_lastRefinements = 0;
+    m_lastFallback = false;
+    if (m_maxRefinements > 0 &&
+        conditionEstimate(a, b, c) * std::numeric_limits<float>::epsilon() > kMaxConditionFloat) {
+        m_lastFallback = true;
+        solveDouble(a, b, c, d, u);
+        return;
+    }
+
+    factorize(a, b, c);
+    u.resize(size);
+    sweep(d.data(), u.data());
+
+    // Итерационное уточнение: r = d - A u в double, A δ = r в float, u += δ
+    m_residual.resize(size);
+    m_correction.resize(size);
+    double correction = std::numeric_limits<double>::infinity();
+    double solutionNorm = maxNorm(u);
+    for (int step = 0; step < m_maxRefinements; ++step) {
+        m_residual[0] = d[0] - b[0] * u[0] - c[0] * u[1];
+        for (size_t i = 1; i + 1 < size; ++i) {
+            m_residual[i] = d[i] - a[i] * u[i - 1] - b[i] * u[i] - c[i] * u[i + 1];
+        }
+        m_residual[size - 1] = d[size - 1] - a[size - 1] * u[size - 2] - b[size - 1] * u[size - 1];
+
+        sweep(m_residual.data(), m_correction.data());
+        for (size_t i = 0; i < size; ++i) {
+            u[i] += m_correction[i];
+        }
+        ++m_lastRefinements;
+
+        // Первая поправка близка к ошибке решения в float, поэтому её отношение
+        // к решению оценивает множитель сходимости ~ cond(A) * eps_float
+        const double previous = step == 0 ? solutionNorm : correction;
+        correction = maxNorm(m_correction);
+        solutionNorm = maxNorm(u);
+        if (correction <= kConvergedCorrection * solutionNorm || correction > 0.5 * previous) {
+            break;
+        }
+    }
+
+    // Без шагов уточнения принимается решение в float
+    if (m_maxRefinements > 0 && !(correction <= kAcceptedCorrection * solutionNorm)) {
+        m_lastFallback = true;
+        solveDouble(a, b, c, d, u);
+    }
+}
+
+void MixedPrecisionSolver::solveDouble(const std::vector<double>& a,
+                                       const std::vector<double>& b,
+                                       const std::vector<double>& c,
+                                       const std::vector<double>& d,
+                                       std::vector<double>& u) {
+    const size_t size = b.size();
+    m_pDouble.resize(size);
+    u.resize(size);
+
+    checkPivot(b[0]);
+    m_pDouble[0] = -c[0] / b[0];
+    u[0] = d[0] / b[0];
+    for (size_t i = 1; i < size; ++i) {
+        double denom = b[i] + a[i] * m_pDouble[i - 1];
+        checkPivot(denom);
+        m_pDouble[i] = -c[i] / denom;
+        u[i] = (d[i] - a[i] * u[i - 1]) / denom;
+    }
+    for (size_t i = size - 1; i-- > 0;) {
+        u[i] += m_pDouble[i] * u[i + 1];
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Прогонка в смешанной точности: разложение и прогонки выполняются в float
+// (вдвое меньше памяти на узел), невязка и поправки накапливаются в double.
+// Итерационное уточнение сходится, пока число обусловленности системы много
+// меньше 1 / eps_float; для сеточного оператора -u'' это n порядка 10^3.
+// Перед разложением cond(A) оценивается за один проход по диагоналям
+// (conditionEstimate): при cond(A) * eps_float > 1/4 уточнение не сходится,
+// и система сразу решается обычной прогонкой в double. Если оценка занижена,
+// это видно по первой поправке: когда она не убывает хотя бы вдвое,
+// система также решается в double.
+class MixedPrecisionSolver {
+public:
+    explicit MixedPrecisionSolver(int maxRefinements = 3);
+
+    int maxRefinements() const { return m_maxRefinements; }
+    void setMaxRefinements(int maxRefinements);
+
+    void solve(const std::vector<double>& a,
+               const std::vector<double>& b,
+               const std::vector<double>& c,
+               const std::vector<double>& d,
+               std::vector<double>& u);
+
+    // Оценка числа обусловленности в max-норме: ||A|| / min(|b| - |a| - |c|) для строго
+    // диагонально доминирующей матрицы, иначе как у разностного оператора второго
+    // порядка: 4 n^2 / pi^2 * (max / min) внедиагональной связи |a| + |c|
+    static double conditionEstimate(const std::vector<double>& a,
+                                    const std::vector<double>& b,
+                                    const std::vector<double>& c);
+
+    // Итоги последнего решения
+    int lastRefinements() const { return m_lastRefinements; }
+    bool lastFallback() const { return m_lastFallback; }
+
+private:
+    void factorize(const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& c);
+    void sweep(const double* rhs, double* x);
+    void solveDouble(const std::vector<double>& a, const std::vector<double>& b,
+                     const std::vector<double>& c, const std::vector<double>& d,
+                     std::vector<double>& u);
+
+    int m_maxRefinements;
+    int m_lastRefinements = 0;
+    bool m_lastFallback = false;
+
+    // Разложение в float
+    std::vector<float> m_a;
+    std::vector<float> m_p;
+    std::vector<float> m_invDenom;
+    std::vector<float> m_q;
+
+    std::vector<double> m_residual;
+    std::vector<double> m_correction;
+    std::vector<double> m_pDouble; // Прогоночные коэффициенты запасного пути
+};
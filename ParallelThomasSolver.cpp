@@ -0,0 +1,284 @@
+#include "ParallelThomasSolver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const double kZeroPivot = 1e-12;
+
+void checkPivot(double denom) {
+    if (std::fabs(denom) < kZeroPivot) { // Проверка на деление на ноль
+        throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+    }
+}
+
+double checkedInverse(double denom) {
+    checkPivot(denom);
+    return 1.0 / denom;
+}
+
+// Обычная прогонка для системы с единичной диагональю (редуцированная система)
+void unitDiagonalThomas(const std::vector<double>& a, const std::vector<double>& c,
+                        const std::vector<double>& d, std::vector<double>& p,
+                        std::vector<double>& u) {
+    const int n = static_cast<int>(d.size());
+    p[0] = -c[0];
+    u[0] = d[0];
+    for (int i = 1; i < n; ++i) {
+        double r = checkedInverse(1.0 + a[i] * p[i - 1]);
+        p[i] = -c[i] * r;
+        u[i] = (d[i] - a[i] * u[i - 1]) * r;
+    }
+    for (int i = n - 2; i >= 0; --i) {
+        u[i] += p[i] * u[i + 1];
+    }
+}
+
+} // namespace
+
+// Поток k выполняет блок k; блок 0 — вызывающий поток. Потоки ждут очередного
+// поколения на условной переменной, вызывающий поток — завершения всех блоков
+class ParallelThomasSolver::WorkerPool {
+public:
+    explicit WorkerPool(int workers) {
+        m_workers.reserve(workers);
+        try {
+            for (int k = 1; k <= workers; ++k) {
+                m_workers.emplace_back([this, k] { work(k); });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ~WorkerPool() { stop(); }
+
+    int workers() const { return static_cast<int>(m_workers.size()); }
+
+    // body(k) для k = 0..blocks-1; исключение первого упавшего блока пробрасывается
+    template <typename Body>
+    void run(int blocks, const Body& body) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_body = &body;
+            m_invoke = [](const void* target, int k) { (*static_cast<const Body*>(target))(k); };
+            m_blocks = blocks;
+            m_pending = blocks - 1;
+            m_errors.assign(blocks, nullptr);
+            ++m_generation;
+        }
+        m_start.notify_all();
+        try {
+            body(0);
+        } catch (...) {
+            m_errors[0] = std::current_exception();
+        }
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_pending == 0; });
+        }
+        for (const std::exception_ptr& error : m_errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+private:
+    void work(int k) {
+        long long seen = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_start.wait(lock, [&] { return m_stopped || m_generation != seen; });
+            if (m_stopped) {
+                return;
+            }
+            seen = m_generation;
+            if (k >= m_blocks) {
+                continue;
+            }
+            lock.unlock();
+            try {
+                m_invoke(m_body, k);
+            } catch (...) {
+                m_errors[k] = std::current_exception();
+            }
+            lock.lock();
+            if (--m_pending == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_start.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    const void* m_body = nullptr;
+    void (*m_invoke)(const void*, int) = nullptr;
+    int m_blocks = 0;
+    int m_pending = 0;
+    long long m_generation = 0;
+    bool m_stopped = false;
+    std::vector<std::exception_ptr> m_errors; // Блок k пишет только свой элемент
+};
+
+ParallelThomasSolver::ParallelThomasSolver(int threads) {
+    setThreads(threads);
+}
+
+ParallelThomasSolver::ParallelThomasSolver(const ParallelThomasSolver& other)
+    : m_threads(other.m_threads) {}
+
+ParallelThomasSolver::ParallelThomasSolver(ParallelThomasSolver&& other) noexcept = default;
+
+ParallelThomasSolver& ParallelThomasSolver::operator=(const ParallelThomasSolver& other) {
+    setThreads(other.m_threads);
+    return *this;
+}
+
+ParallelThomasSolver& ParallelThomasSolver::operator=(ParallelThomasSolver&& other) noexcept = default;
+
+ParallelThomasSolver::~ParallelThomasSolver() = default;
+
+void ParallelThomasSolver::setThreads(int threads) {
+    const int count = threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (m_pool && count != m_threads) {
+        m_pool.reset();
+    }
+    m_threads = count;
+}
+
+int ParallelThomasSolver::blocks(int n) const {
+    return std::min(m_threads, n / minBlockSize);
+}
+
+void ParallelThomasSolver::solve(const std::vector<double>& a,
+                                 const std::vector<double>& b,
+                                 const std::vector<double>& c,
+                                 const std::vector<double>& d,
+                                 std::vector<double>& u) {
+    const int n = static_cast<int>(b.size());
+    const int blocks = this->blocks(n);
+
+    if (&u == &d) {
+        throw std::invalid_argument("Правая часть и решение должны быть разными массивами");
+    }
+    m_a.resize(n);
+    m_c.resize(n);
+    u.resize(n);
+
+    if (blocks < 2) {
+        // Последовательная прогонка, как в SolverModel::thomasAlgorithm:
+        // m_a хранит p, u — сначала q, затем решение
+        double* p = m_a.data();
+        p[0] = -c[0] / b[0];
+        u[0] = d[0] / b[0];
+        for (int i = 1; i < n; ++i) {
+            double denom = b[i] + a[i] * p[i - 1];
+            checkPivot(denom);
+            p[i] = -c[i] / denom;
+            u[i] = (d[i] - a[i] * u[i - 1]) / denom;
+        }
+        for (int i = n - 2; i >= 0; --i) {
+            u[i] = p[i] * u[i + 1] + u[i];
+        }
+        return;
+    }
+
+    if (!m_pool) {
+        m_pool = std::make_unique<WorkerPool>(m_threads - 1);
+    }
+
+    auto blockBegin = [n, blocks](int k) {
+        return static_cast<int>(static_cast<long long>(n) * k / blocks);
+    };
+
+    // Модифицированная прогонка внутри блоков: строка i приводится к виду
+    // A_i x_first + x_i + C_i x_last = D_i, а крайние строки блока — к
+    // A x_{first-1} + x_first + C x_last = D и A x_first + x_last + C x_{last+1} = D
+    m_pool->run(blocks, [&](int k) {
+        const int first = blockBegin(k);
+        const int last = blockBegin(k + 1) - 1;
+        double* A = m_a.data();
+        double* C = m_c.data();
+        double* D = u.data();
+
+        for (int i = first; i <= first + 1; ++i) {
+            double r = checkedInverse(b[i]);
+            A[i] = a[i] * r;
+            C[i] = c[i] * r;
+            D[i] = d[i] * r;
+        }
+
+        // Прямой ход: исключение x_{i-1}
+        for (int i = first + 2; i <= last; ++i) {
+            double r = checkedInverse(b[i] - a[i] * C[i - 1]);
+            D[i] = (d[i] - a[i] * D[i - 1]) * r;
+            C[i] = c[i] * r;
+            A[i] = -a[i] * A[i - 1] * r;
+        }
+
+        // Обратный ход: исключение x_{i+1} через последнюю неизвестную блока
+        for (int i = last - 2; i > first; --i) {
+            D[i] -= C[i] * D[i + 1];
+            A[i] -= C[i] * A[i + 1];
+            C[i] = -C[i] * C[i + 1];
+        }
+
+        double r = checkedInverse(1.0 - C[first] * A[first + 1]);
+        D[first] = (D[first] - C[first] * D[first + 1]) * r;
+        A[first] *= r;
+        C[first] = -C[first] * C[first + 1] * r;
+    });
+
+    // Редуцированная система для первой и последней неизвестных каждого блока
+    const int reduced = 2 * blocks;
+    m_reducedA.resize(reduced);
+    m_reducedC.resize(reduced);
+    m_reducedD.resize(reduced);
+    m_reducedP.resize(reduced);
+    m_reducedU.resize(reduced);
+    for (int k = 0; k < blocks; ++k) {
+        const int first = blockBegin(k);
+        const int last = blockBegin(k + 1) - 1;
+        for (int j = 0; j < 2; ++j) {
+            const int row = j == 0 ? first : last;
+            m_reducedA[2 * k + j] = m_a[row];
+            m_reducedC[2 * k + j] = m_c[row];
+            m_reducedD[2 * k + j] = u[row];
+        }
+    }
+    unitDiagonalThomas(m_reducedA, m_reducedC, m_reducedD, m_reducedP, m_reducedU);
+
+    // Восстановление внутренних неизвестных блоков
+    m_pool->run(blocks, [&](int k) {
+        const int first = blockBegin(k);
+        const int last = blockBegin(k + 1) - 1;
+        const double xFirst = m_reducedU[2 * k];
+        const double xLast = m_reducedU[2 * k + 1];
+
+        u[first] = xFirst;
+        for (int i = first + 1; i < last; ++i) {
+            u[i] -= m_a[i] * xFirst + m_c[i] * xLast;
+        }
+        u[last] = xLast;
+    });
+}
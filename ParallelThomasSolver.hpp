@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+// Параллельная прогонка методом разбиения (partition method).
+// Матрица делится на блоки по числу потоков; в каждом блоке модифицированная
+// прогонка выражает все неизвестные через первую и последнюю неизвестные блока.
+// Эти граничные неизвестные образуют трёхдиагональную систему размера 2 * blocks,
+// которая решается обычной прогонкой, после чего блоки восстанавливаются параллельно.
+// Потоки блоков создаются при первом разбиении и ждут следующих вызовов solve;
+// копия решателя получает собственные потоки. Один объект не используется из
+// нескольких потоков одновременно
+class ParallelThomasSolver {
+public:
+    // threads = 0 — по числу аппаратных потоков
+    explicit ParallelThomasSolver(int threads = 0);
+    ParallelThomasSolver(const ParallelThomasSolver& other);
+    ParallelThomasSolver(ParallelThomasSolver&& other) noexcept;
+    ParallelThomasSolver& operator=(const ParallelThomasSolver& other);
+    ParallelThomasSolver& operator=(ParallelThomasSolver&& other) noexcept;
+    ~ParallelThomasSolver();
+
+    int threads() const { return m_threads; }
+    // Потоки пересоздаются при следующем разбиении, если их число изменилось
+    void setThreads(int threads);
+
+    // Число блоков для системы из n уравнений; меньше 2 — последовательная прогонка
+    int blocks(int n) const;
+
+    // Решение системы; при малом размере блоков используется последовательная прогонка
+    void solve(const std::vector<double>& a,
+               const std::vector<double>& b,
+               const std::vector<double>& c,
+               const std::vector<double>& d,
+               std::vector<double>& u);
+
+    // Минимальная длина блока, при которой имеет смысл разбиение
+    static const int minBlockSize = 1 << 14;
+
+private:
+    class WorkerPool;
+
+    int m_threads;
+    std::unique_ptr<WorkerPool> m_pool; // Потоки блоков 1..m_threads-1
+
+    // Модифицированные коэффициенты блоков; правая часть хранится прямо в u
+    std::vector<double> m_a;
+    std::vector<double> m_c;
+
+    // Редуцированная система для граничных неизвестных блоков
+    std::vector<double> m_reducedA;
+    std::vector<double> m_reducedC;
+    std::vector<double> m_reducedD;
+    std::vector<double> m_reducedP;
+    std::vector<double> m_reducedU;
+};
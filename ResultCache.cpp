@@ -0,0 +1,93 @@
+#include "ResultCache.hpp"
+
+namespace {
+
+template <typename T>
+size_t vectorBytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+} // namespace
+
+ResultCache::ResultCache(size_t memoryBudget) : m_memoryBudget(memoryBudget) {}
+
+std::shared_ptr<const SolverModel::Result> ResultCache::find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        ++m_stats.misses;
+        return nullptr;
+    }
+    ++m_stats.hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->result;
+}
+
+void ResultCache::insert(const std::string& key, std::shared_ptr<const SolverModel::Result> result) {
+    const size_t bytes = sizeof(SolverModel::Result) + resultBytes(*result);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_memoryUsage -= it->second->bytes;
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+    if (bytes > m_memoryBudget) {
+        return;
+    }
+
+    evict(m_memoryBudget - bytes);
+    m_entries.push_front({key, std::move(result), bytes});
+    m_index[key] = m_entries.begin();
+    m_memoryUsage += bytes;
+}
+
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_memoryUsage = 0;
+}
+
+void ResultCache::setMemoryBudget(size_t memoryBudget) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryBudget = memoryBudget;
+    evict(memoryBudget);
+}
+
+size_t ResultCache::memoryBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryBudget;
+}
+
+size_t ResultCache::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryUsage;
+}
+
+size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+ResultCache::Stats ResultCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+size_t ResultCache::resultBytes(const SolverModel::Result& result) {
+    // Разделяемые массивы учитываются в каждом результате, который их удерживает
+    return result.x.nodes().bytes() + vectorBytes(result.u) + result.xRefined.nodes().bytes()
+         + result.uRefined.bytes() + vectorBytes(result.convergenceData) + vectorBytes(result.timingData);
+}
+
+void ResultCache::evict(size_t budget) {
+    while (m_memoryUsage > budget && !m_entries.empty()) {
+        const Entry& oldest = m_entries.back();
+        m_memoryUsage -= oldest.bytes;
+        m_index.erase(oldest.key);
+        m_entries.pop_back();
+        ++m_stats.evictions;
+    }
+}
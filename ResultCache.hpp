@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "SolverModel.hpp"
+
+// Кэш результатов SolverModel с вытеснением давно не использованных (LRU)
+// при превышении бюджета памяти. Ключ строит модель из задачи и всех параметров,
+// влияющих на решение. Результаты хранятся как shared_ptr<const Result>:
+// попадание не копирует массивы, а вытеснение не портит уже выданные результаты.
+// Потокобезопасен — один кэш разделяют копии модели в разных потоках
+class ResultCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    // memoryBudget — предельный суммарный объём массивов результатов в байтах
+    explicit ResultCache(size_t memoryBudget = size_t(256) << 20);
+
+    std::shared_ptr<const SolverModel::Result> find(const std::string& key);
+    // Результат больше бюджета не кэшируется; существующая запись заменяется
+    void insert(const std::string& key, std::shared_ptr<const SolverModel::Result> result);
+    void clear();
+
+    void setMemoryBudget(size_t memoryBudget);
+    size_t memoryBudget() const;
+    size_t memoryUsage() const;
+    size_t size() const;
+    Stats stats() const;
+
+    // Объём массивов результата по их ёмкости; узлы равномерной сетки
+    // и аналитическое решение не хранятся
+    static size_t resultBytes(const SolverModel::Result& result);
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const SolverModel::Result> result;
+        size_t bytes;
+    };
+
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries; // В начале — недавно использованные
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    size_t m_memoryBudget;
+    size_t m_memoryUsage = 0;
+    Stats m_stats;
+
+    void evict(size_t budget);
+};
@@ -0,0 +1,346 @@
+#include "ResultFile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RESULT_FILE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char kMagic[8] = {'T', 'H', 'O', 'M', 'R', 'E', 'S', '1'};
+const int64_t kAlignment = 64;
+const size_t kBlock = 1 << 16; // Узлов в блоке записи вычисляемых массивов (512 КБ)
+
+int64_t alignUp(int64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+bool isLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Заголовок .npy 1.0: магическая строка, версия, длина словаря и словарь,
+// дополненный пробелами так, чтобы данные начинались на границе 64 байт
+std::string npyHeader(int64_t rows, int64_t columns) {
+    std::string shape = columns == 1 ? "(" + std::to_string(rows) + ",)"
+                                     : "(" + std::to_string(rows) + ", " + std::to_string(columns) + ")";
+    std::string dictionary = "{'descr': '<f8', 'fortran_order': False, 'shape': " + shape + ", }";
+    const size_t preamble = 10;
+    const size_t total = static_cast<size_t>(alignUp(static_cast<int64_t>(preamble + dictionary.size() + 1)));
+    dictionary.append(total - preamble - dictionary.size() - 1, ' ');
+    dictionary += '\n';
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    const uint16_t length = static_cast<uint16_t>(dictionary.size());
+    header += static_cast<char>(length & 0xff);
+    header += static_cast<char>(length >> 8);
+    return header + dictionary;
+}
+
+// Массив к записи: данные из памяти либо блоки, вычисляемые при записи
+struct PendingArray {
+    std::string name;
+    int64_t rows;
+    int64_t columns;
+    const double* data;                                  // nullptr — вычисляется fill
+    std::function<void(size_t, size_t, double*)> fill;   // Элементы first .. first + count - 1
+};
+
+#ifdef RESULT_FILE_POSIX
+[[noreturn]] void throwSystemError(const std::string& what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+#endif
+
+} // namespace
+
+void writeResultFile(const std::string& path, const SolverModel::Params& params,
+                     const SolverModel::Result& result, const std::string& problem) {
+    if (!isLittleEndian()) {
+        throw std::runtime_error("Формат результата поддерживается только на little-endian системах");
+    }
+    if (result.u.empty() || result.x.size() != result.u.size()) {
+        throw std::invalid_argument("Результат не содержит решения");
+    }
+
+    ResultFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.headerBytes = sizeof(ResultFileHeader);
+    std::strncpy(header.problem, problem.c_str(), sizeof(header.problem) - 1);
+    header.mu1 = params.mu1;
+    header.mu2 = params.mu2;
+    header.xi = params.xi;
+    header.epsilon = params.epsilon;
+    header.n = params.n;
+    header.method = static_cast<int64_t>(params.method);
+    header.threads = params.threads;
+    header.richardson = params.richardson;
+    header.refinements = params.refinements;
+    header.cancelled = result.cancelled;
+    header.maxError = result.maxError;
+    header.maxErrorRefined = result.maxErrorRefined;
+    header.normsMaxError = result.norms.maxError;
+    header.normsMaxIndex = static_cast<int64_t>(result.norms.maxIndex);
+    header.l2Error = result.norms.l2Error;
+    header.relativeError = result.norms.relativeError;
+    header.gridError = result.norms.gridError;
+    header.uniformN = result.x.isUniform() ? static_cast<int64_t>(result.x.size()) - 1 : 0;
+    header.uniformRefinedN = result.xRefined.isUniform() && !result.xRefined.empty()
+                                 ? static_cast<int64_t>(result.xRefined.size()) - 1 : 0;
+    const int phases = std::min(PhaseTimings::phaseCount, ResultFileHeader::kMaxPhases);
+    header.phaseCount = phases;
+    std::copy(result.timings.seconds, result.timings.seconds + phases, header.timings);
+
+    std::vector<PendingArray> arrays;
+    const int64_t size = static_cast<int64_t>(result.u.size());
+    arrays.push_back({"u", size, 1, result.u.data(), nullptr});
+    if (!result.analytical.empty()) {
+        arrays.push_back({"analytical", size, 1, nullptr, [&](size_t first, size_t count, double* out) {
+            result.analytical.evaluate(first, count, out);
+        }});
+    }
+    if (!result.x.isUniform()) {
+        arrays.push_back({"x", size, 1, result.x.nodes().data(), nullptr});
+    }
+    if (!result.uRefined.empty()) {
+        const int64_t refinedSize = static_cast<int64_t>(result.uRefined.size());
+        arrays.push_back({"u_refined", refinedSize, 1, result.uRefined.data(), nullptr});
+        if (!result.analyticalRefined.empty()) {
+            arrays.push_back({"analytical_refined", refinedSize, 1, nullptr, [&](size_t first, size_t count, double* out) {
+                result.analyticalRefined.evaluate(first, count, out);
+            }});
+        }
+        if (!result.xRefined.isUniform()) {
+            arrays.push_back({"x_refined", refinedSize, 1, result.xRefined.nodes().data(), nullptr});
+        }
+    }
+    if (!result.convergenceData.empty()) {
+        arrays.push_back({"convergence", static_cast<int64_t>(result.convergenceData.size()), 2, nullptr,
+                          [&](size_t first, size_t count, double* out) {
+            for (size_t j = 0; j < count; ++j) {
+                const size_t level = (first + j) / 2;
+                out[j] = (first + j) % 2 == 0 ? result.convergenceData[level].n
+                                              : result.convergenceData[level].error;
+            }
+        }});
+    }
+    if (!result.timingData.empty()) {
+        arrays.push_back({"timing_levels", static_cast<int64_t>(result.timingData.size()), phases, nullptr,
+                          [&](size_t first, size_t count, double* out) {
+            for (size_t j = 0; j < count; ++j) {
+                out[j] = result.timingData[(first + j) / phases].seconds[(first + j) % phases];
+            }
+        }});
+    }
+
+    // Размещение массивов
+    std::vector<std::string> npyHeaders;
+    int64_t cursor = sizeof(ResultFileHeader);
+    for (const PendingArray& array : arrays) {
+        ResultFileArray& entry = header.arrays[header.arrayCount++];
+        std::strncpy(entry.name, array.name.c_str(), sizeof(entry.name) - 1);
+        entry.rows = array.rows;
+        entry.columns = array.columns;
+        entry.offset = alignUp(cursor);
+        npyHeaders.push_back(npyHeader(array.rows, array.columns));
+        entry.dataOffset = entry.offset + static_cast<int64_t>(npyHeaders.back().size());
+        cursor = entry.dataOffset + array.rows * array.columns * static_cast<int64_t>(sizeof(double));
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть " + path);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    int64_t position = sizeof(ResultFileHeader);
+    std::vector<double> buffer;
+    const char padding[kAlignment] = {};
+    for (size_t k = 0; k < arrays.size(); ++k) {
+        const PendingArray& array = arrays[k];
+        const ResultFileArray& entry = header.arrays[k];
+        file.write(padding, entry.offset - position);
+        file.write(npyHeaders[k].data(), static_cast<std::streamsize>(npyHeaders[k].size()));
+
+        const size_t count = static_cast<size_t>(array.rows * array.columns);
+        if (array.data) {
+            file.write(reinterpret_cast<const char*>(array.data), static_cast<std::streamsize>(count * sizeof(double)));
+        } else {
+            buffer.resize(std::min(kBlock, count));
+            for (size_t first = 0; first < count; first += kBlock) {
+                const size_t block = std::min(kBlock, count - first);
+                array.fill(first, block, buffer.data());
+                file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(block * sizeof(double)));
+            }
+        }
+        position = entry.dataOffset + static_cast<int64_t>(count * sizeof(double));
+    }
+    if (!file) {
+        throw std::runtime_error("Ошибка записи " + path);
+    }
+}
+
+MappedResultFile::MappedResultFile(const std::string& path) {
+#ifdef RESULT_FILE_POSIX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throwSystemError("Не удалось открыть файл " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throwSystemError("Не удалось определить размер файла " + path);
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size >= sizeof(ResultFileHeader)) {
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            throwSystemError("Не удалось отобразить файл " + path);
+        }
+        m_data = static_cast<const char*>(data);
+    }
+    ::close(fd); // Отображение остаётся действительным и без дескриптора
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл " + path);
+    }
+    m_size = static_cast<size_t>(file.tellg());
+    m_buffer.resize(m_size);
+    file.seekg(0);
+    file.read(m_buffer.data(), static_cast<std::streamsize>(m_size));
+    m_data = m_buffer.data();
+#endif
+
+    // Проверка заголовка и границ всех массивов до первого обращения к ним
+    auto fail = [this, &path](const char* what) {
+#ifdef RESULT_FILE_POSIX
+        if (m_data) {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+        throw std::runtime_error(path + ": " + what);
+    };
+    if (m_size < sizeof(ResultFileHeader) || std::memcmp(header().magic, kMagic, sizeof(kMagic)) != 0) {
+        fail("не файл результата");
+    }
+    const ResultFileHeader& h = header();
+    if (h.headerBytes != static_cast<int64_t>(sizeof(ResultFileHeader)) ||
+        h.arrayCount < 0 || h.arrayCount > ResultFileHeader::kMaxArrays ||
+        h.phaseCount < 0 || h.phaseCount > ResultFileHeader::kMaxPhases) {
+        fail("повреждённый заголовок");
+    }
+    for (int64_t k = 0; k < h.arrayCount; ++k) {
+        const ResultFileArray& array = h.arrays[k];
+        if (array.rows < 0 || array.columns < 1 || array.dataOffset % kAlignment != 0 ||
+            array.dataOffset < static_cast<int64_t>(sizeof(ResultFileHeader)) ||
+            static_cast<uint64_t>(array.rows) * array.columns >
+                (m_size - static_cast<uint64_t>(std::min<int64_t>(array.dataOffset, m_size))) / sizeof(double)) {
+            fail("массив выходит за пределы файла");
+        }
+    }
+}
+
+MappedResultFile::~MappedResultFile() {
+#ifdef RESULT_FILE_POSIX
+    if (m_data) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+}
+
+SolverModel::Params MappedResultFile::params() const {
+    const ResultFileHeader& h = header();
+    SolverModel::Params params{h.mu1, h.mu2, h.xi, static_cast<int>(h.n), h.epsilon};
+    params.method = static_cast<SolverModel::Method>(h.method);
+    params.threads = static_cast<int>(h.threads);
+    params.richardson = h.richardson != 0;
+    params.refinements = static_cast<int>(h.refinements);
+    return params;
+}
+
+const ResultFileArray* MappedResultFile::find(const char* name) const {
+    const ResultFileHeader& h = header();
+    for (int64_t k = 0; k < h.arrayCount; ++k) {
+        if (std::strncmp(h.arrays[k].name, name, sizeof(h.arrays[k].name)) == 0) {
+            return &h.arrays[k];
+        }
+    }
+    return nullptr;
+}
+
+const double* MappedResultFile::data(const ResultFileArray& array) const {
+    return reinterpret_cast<const double*>(m_data + array.dataOffset);
+}
+
+std::shared_ptr<const SolverModel::Result> loadResultFile(const std::string& path, SolverModel::Params* params) {
+    auto file = std::make_shared<const MappedResultFile>(path);
+    const ResultFileHeader& h = file->header();
+    auto array = [&file](const char* name) {
+        const ResultFileArray* entry = file->find(name);
+        return entry ? SharedArray(file, file->data(*entry), static_cast<size_t>(entry->rows * entry->columns))
+                     : SharedArray();
+    };
+
+    auto result = std::make_shared<SolverModel::Result>();
+    const SharedArray u = array("u");
+    result->u.assign(u.begin(), u.end());
+    result->x = h.uniformN > 0 ? GridView::uniform(static_cast<int>(h.uniformN)) : GridView::nodes(array("x"));
+    result->analytical = AnalyticalView(array("analytical"));
+    if (result->u.size() < 2 || result->x.size() != result->u.size() ||
+        (!result->analytical.empty() && result->analytical.size() != result->u.size())) {
+        throw std::runtime_error(path + ": размеры массивов решения не совпадают");
+    }
+
+    result->uRefined = array("u_refined");
+    if (!result->uRefined.empty()) {
+        result->xRefined = h.uniformRefinedN > 0 ? GridView::uniform(static_cast<int>(h.uniformRefinedN))
+                                                 : GridView::nodes(array("x_refined"));
+        result->analyticalRefined = AnalyticalView(array("analytical_refined"));
+    }
+
+    result->maxError = h.maxError;
+    result->maxErrorRefined = h.maxErrorRefined;
+    result->norms.maxError = h.normsMaxError;
+    result->norms.maxIndex = static_cast<size_t>(h.normsMaxIndex);
+    result->norms.l2Error = h.l2Error;
+    result->norms.relativeError = h.relativeError;
+    result->norms.gridError = h.gridError;
+    result->cancelled = h.cancelled != 0;
+
+    const int phases = std::min<int>(static_cast<int>(h.phaseCount), PhaseTimings::phaseCount);
+    std::copy(h.timings, h.timings + phases, result->timings.seconds);
+    if (const ResultFileArray* entry = file->find("convergence")) {
+        const double* values = file->data(*entry);
+        for (int64_t level = 0; level < entry->rows && entry->columns == 2; ++level) {
+            result->convergenceData.push_back({static_cast<int>(values[2 * level]), values[2 * level + 1]});
+        }
+    }
+    if (const ResultFileArray* entry = file->find("timing_levels")) {
+        const double* values = file->data(*entry);
+        const int columns = static_cast<int>(std::min<int64_t>(entry->columns, PhaseTimings::phaseCount));
+        result->timingData.resize(static_cast<size_t>(entry->rows));
+        for (int64_t level = 0; level < entry->rows; ++level) {
+            std::copy(values + level * entry->columns, values + level * entry->columns + columns,
+                      result->timingData[level].seconds);
+        }
+    }
+
+    if (params) {
+        *params = file->params();
+    }
+    return result;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SolverModel.hpp"
+
+// Двоичный файл результата (*.res) для сохранения, повторной загрузки и внешнего анализа.
+// Числа little-endian. В начале — заголовок ResultFileHeader (все поля по 8 байт,
+// без выравнивающих промежутков), за ним массивы. Каждый массив — самостоятельный
+// NumPy .npy версии 1.0 ('<f8', C-порядок), начало и данные которого выровнены на 64 байта:
+//   np.memmap(path, '<f8', 'r', offset=dataOffset, shape=(rows, columns))
+//   или f.seek(offset); np.lib.format.read_array(f)
+// Массивы: u, analytical, x (только неравномерная сетка), u_refined, analytical_refined,
+// x_refined, convergence (уровни x 2: n, ошибка), timing_levels (уровни x фазы, с).
+// Равномерная сетка не записывается: x_i = i / uniformN.
+
+struct ResultFileArray {
+    char name[32];      // Имя, дополненное нулями
+    int64_t offset;     // Начало .npy
+    int64_t dataOffset; // Начало данных
+    int64_t rows;
+    int64_t columns;    // 1 для векторов
+};
+
+struct alignas(64) ResultFileHeader {
+    static const int kMaxArrays = 8;
+    static const int kMaxPhases = 16;
+
+    char magic[8];       // "THOMRES1"
+    int64_t headerBytes; // sizeof(ResultFileHeader)
+    char problem[32];    // Имя задачи (ProblemKernels::name)
+
+    // SolverModel::Params
+    double mu1;
+    double mu2;
+    double xi;
+    double epsilon;
+    int64_t n;
+    int64_t method;
+    int64_t threads;
+    int64_t richardson;
+    int64_t refinements;
+
+    // Сводка SolverModel::Result
+    int64_t cancelled;
+    double maxError;
+    double maxErrorRefined;
+    double normsMaxError;
+    int64_t normsMaxIndex;
+    double l2Error;
+    double relativeError;
+    double gridError;
+    int64_t uniformN;        // Разбиений равномерной сетки x; 0 — узлы в массиве x
+    int64_t uniformRefinedN; // То же для x_refined
+    int64_t phaseCount;
+    double timings[kMaxPhases]; // Время фаз последнего уровня, с
+
+    int64_t arrayCount;
+    ResultFileArray arrays[kMaxArrays];
+};
+
+// Запись крупными последовательными блоками; массивы, которых нет в памяти
+// (равномерная сетка, аналитическое решение), вычисляются по ходу записи
+void writeResultFile(const std::string& path, const SolverModel::Params& params,
+                     const SolverModel::Result& result, const std::string& problem = std::string());
+
+// Файл результата, отображённый в память только для чтения; массивы читаются без копирования
+class MappedResultFile {
+public:
+    explicit MappedResultFile(const std::string& path);
+    ~MappedResultFile();
+
+    MappedResultFile(const MappedResultFile&) = delete;
+    MappedResultFile& operator=(const MappedResultFile&) = delete;
+
+    const ResultFileHeader& header() const { return *reinterpret_cast<const ResultFileHeader*>(m_data); }
+    SolverModel::Params params() const;
+
+    // Описание массива по имени; nullptr, если он не записан
+    const ResultFileArray* find(const char* name) const;
+    const double* data(const ResultFileArray& array) const;
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    std::vector<char> m_buffer; // Содержимое файла там, где нет mmap
+};
+
+// Результат из файла для отображения: u копируется (Result::u — собственный вектор),
+// остальные массивы ссылаются на отображение, которое живёт, пока жив результат.
+// params, если задан, получает параметры решения
+std::shared_ptr<const SolverModel::Result> loadResultFile(const std::string& path,
+                                                          SolverModel::Params* params = nullptr);
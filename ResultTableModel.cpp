@@ -0,0 +1,96 @@
+#include "ResultTableModel.hpp"
+#include <QHeaderView>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+ResultTableModel::ResultTableModel(Layout layout, QObject* parent)
+    : QAbstractTableModel(parent), m_layout(layout) {}
+
+void ResultTableModel::setResult(std::shared_ptr<const SolverModel::Result> result) {
+    beginResetModel();
+    m_result = std::move(result);
+    endResetModel();
+}
+
+int ResultTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !m_result) {
+        return 0;
+    }
+    const SolverModel::Result& result = *m_result;
+    if (m_layout == Layout::Solution) {
+        return static_cast<int>(result.x.size());
+    }
+    // Узлы предыдущего уровня совпадают с чётными узлами последнего
+    return static_cast<int>(std::min(result.uRefined.size(), (result.u.size() + 1) / 2));
+}
+
+int ResultTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : 4;
+}
+
+double ResultTableModel::value(int row, int column) const {
+    const SolverModel::Result& result = *m_result;
+    const size_t i = static_cast<size_t>(row);
+
+    if (m_layout == Layout::Solution) {
+        // Для задач без аналитического решения столбцы v и u - v пусты
+        const double analytical = i < result.analytical.size() ? result.analytical[i]
+                                                               : std::numeric_limits<double>::quiet_NaN();
+        switch (column) {
+        case 0: return result.x[i];
+        case 1: return result.u[i];
+        case 2: return analytical;
+        default: return result.u[i] - analytical;
+        }
+    }
+
+    switch (column) {
+    case 0: return result.x[2 * i];
+    case 1: return result.uRefined[i];
+    case 2: return result.u[2 * i];
+    default: return result.uRefined[i] - result.u[2 * i];
+    }
+}
+
+QVariant ResultTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || !m_result) {
+        return QVariant();
+    }
+    if (role == Qt::TextAlignmentRole) {
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    double cell = value(index.row(), index.column());
+    return std::isnan(cell) ? QString() : QString::number(cell);
+}
+
+QVariant ResultTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return section;
+    }
+
+    static const char* const solutionHeaders[] = {"x_i", "u(x_i)", "v(x_i)", "u(x_i) - v(x_i)"};
+    static const char* const comparisonHeaders[] = {"x_{2i}", "u(x_{2i})", "u2(x_{2i})", "u - u2"};
+    if (section < 0 || section >= 4) {
+        return QVariant();
+    }
+    return QString(m_layout == Layout::Solution ? solutionHeaders[section] : comparisonHeaders[section]);
+}
+
+QTableView* createResultTableView(ResultTableModel* model, QWidget* parent) {
+    QTableView* table = new QTableView(parent);
+    table->setModel(model);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    table->horizontalHeader()->setDefaultSectionSize(140);
+    return table;
+}
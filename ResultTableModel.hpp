@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <memory>
+#include "SolverModel.hpp"
+
+// Табличное представление Result без копирования: ячейки читаются из векторов
+// решения и форматируются только при отрисовке, поэтому затраты на показ
+// пропорциональны числу видимых строк, а не n.
+class ResultTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum class Layout {
+        Solution,      // x_i, u(x_i), v(x_i), u - v
+        GridComparison // x_{2i}, u(x_{2i}), u2(x_{2i}), u - u2: предыдущий уровень против последнего
+    };
+
+    explicit ResultTableModel(Layout layout, QObject* parent = nullptr);
+
+    // Результат разделяется с вызывающим кодом и живёт, пока отображается
+    void setResult(std::shared_ptr<const SolverModel::Result> result);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    double value(int row, int column) const;
+
+    Layout m_layout;
+    std::shared_ptr<const SolverModel::Result> m_result;
+};
+
+// Таблица для ResultTableModel: строки одинаковой высоты, ширина столбцов
+// фиксирована, чтобы размеры не пересчитывались по всем n строкам
+QTableView* createResultTableView(ResultTableModel* model, QWidget* parent);
@@ -0,0 +1,70 @@
+#include "ResultViews.hpp"
+#include <algorithm>
+#include <utility>
+
+SharedArray::SharedArray(std::vector<double> values)
+    : SharedArray(std::make_shared<const std::vector<double>>(std::move(values))) {}
+
+SharedArray::SharedArray(std::shared_ptr<const std::vector<double>> values) {
+    if (values) {
+        m_size = values->size();
+        m_bytes = values->capacity() * sizeof(double);
+        const double* data = values->data();
+        m_data = std::shared_ptr<const double>(std::move(values), data);
+    }
+}
+
+SharedArray::SharedArray(std::shared_ptr<const void> owner, const double* data, size_t size)
+    : m_data(std::move(owner), data), m_size(size), m_bytes(size * sizeof(double)) {}
+
+GridView GridView::uniform(int n) {
+    GridView grid;
+    grid.m_n = n;
+    grid.m_h = 1.0 / n;
+    return grid;
+}
+
+GridView GridView::nodes(SharedArray nodes) {
+    GridView grid;
+    grid.m_n = static_cast<int>(nodes.size()) - 1;
+    grid.m_nodes = std::move(nodes);
+    return grid;
+}
+
+void GridView::copy(size_t first, size_t count, double* out) const {
+    for (size_t j = 0; j < count; ++j) {
+        out[j] = (*this)[first + j];
+    }
+}
+
+std::vector<double> GridView::toVector() const {
+    std::vector<double> values(size());
+    copy(0, values.size(), values.data());
+    return values;
+}
+
+AnalyticalView::AnalyticalView(std::shared_ptr<const ProblemKernels> problem, GridView grid)
+    : m_grid(std::move(grid)) {
+    if (problem && problem->hasAnalyticalSolution()) {
+        m_problem = std::move(problem);
+    }
+}
+
+void AnalyticalView::evaluate(size_t first, size_t count, double* out) const {
+    if (!m_problem) {
+        std::copy(m_values.begin() + first, m_values.begin() + first + count, out);
+    } else if (m_grid.isUniform()) {
+        m_problem->evaluateAnalyticalRows(static_cast<long long>(m_grid.size()) - 1,
+                                          static_cast<long long>(first), static_cast<int>(count), out);
+    } else {
+        m_problem->evaluateAnalyticalAt(m_grid.nodes().data() + first, static_cast<int>(count), out);
+    }
+}
+
+std::vector<double> AnalyticalView::toVector() const {
+    std::vector<double> values(size());
+    if (!values.empty()) {
+        evaluate(0, values.size(), values.data());
+    }
+    return values;
+}
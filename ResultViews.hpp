@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "CoefficientPolicy.hpp"
+
+// Массивы SolverModel::Result без собственного хранения: узлы равномерной сетки
+// и аналитическое решение вычисляются по запросу, массивы другого результата
+// разделяются через shared_ptr. Индексация и size() — как у std::vector
+
+// Массив только для чтения, разделяемый несколькими результатами и кэшем
+class SharedArray {
+public:
+    SharedArray() = default;
+    SharedArray(std::vector<double> values);
+    SharedArray(std::shared_ptr<const std::vector<double>> values);
+    // Чужая память (например, отображённый в память файл), которую owner держит живой
+    SharedArray(std::shared_ptr<const void> owner, const double* data, size_t size);
+
+    size_t size() const { return m_size; }
+    bool empty() const { return size() == 0; }
+    double operator[](size_t i) const { return m_data.get()[i]; }
+    const double* data() const { return m_data.get(); }
+    const double* begin() const { return data(); }
+    const double* end() const { return data() + size(); }
+
+    // Объём разделяемого массива в байтах
+    size_t bytes() const { return m_bytes; }
+
+private:
+    std::shared_ptr<const double> m_data; // Начало массива; владеет хранилищем через aliasing
+    size_t m_size = 0;
+    size_t m_bytes = 0;
+};
+
+// Узлы сетки на [0, 1]. Равномерная хранит только число разбиений
+// (x_i = i * h, как при явной генерации), неравномерная — разделяемый массив узлов
+class GridView {
+public:
+    GridView() = default;
+    static GridView uniform(int n);
+    static GridView nodes(SharedArray nodes);
+
+    size_t size() const { return isUniform() ? (m_n > 0 ? static_cast<size_t>(m_n) + 1 : 0) : m_nodes.size(); }
+    bool empty() const { return size() == 0; }
+    bool isUniform() const { return m_nodes.empty(); }
+    double operator[](size_t i) const { return isUniform() ? static_cast<double>(i) * m_h : m_nodes[i]; }
+    const SharedArray& nodes() const { return m_nodes; }
+
+    // Узлы first .. first + count - 1 в out
+    void copy(size_t first, size_t count, double* out) const;
+    std::vector<double> toVector() const;
+
+private:
+    int m_n = 0;
+    double m_h = 0.0;
+    SharedArray m_nodes;
+};
+
+// Аналитическое решение в узлах сетки. Пусто, если у задачи его нет.
+// Вместо задачи может хранить готовые значения (результат, загруженный из файла)
+class AnalyticalView {
+public:
+    AnalyticalView() = default;
+    AnalyticalView(std::shared_ptr<const ProblemKernels> problem, GridView grid);
+    explicit AnalyticalView(SharedArray values) : m_values(std::move(values)) {}
+
+    size_t size() const { return m_problem ? m_grid.size() : m_values.size(); }
+    bool empty() const { return size() == 0; }
+    // Одно значение; для обхода всей сетки быстрее evaluate блоками
+    double operator[](size_t i) const { return m_problem ? m_problem->analytical(m_grid[i]) : m_values[i]; }
+
+    void evaluate(size_t first, size_t count, double* out) const;
+    std::vector<double> toVector() const;
+
+private:
+    std::shared_ptr<const ProblemKernels> m_problem;
+    GridView m_grid;
+    SharedArray m_values;
+};
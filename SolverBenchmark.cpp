@@ -0,0 +1,617 @@
+// Микробенчмарки ядер решателя: время на узел, оценка пропускной способности памяти
+// и число выделений памяти на вызов. Результаты выводятся в JSON и могут
+// сравниваться с сохранённым базовым прогоном (--baseline).
+#include "AdiSolver.hpp"
+#include "BatchThomasSolver.hpp"
+#include "BlockThomasSolver.hpp"
+#include "CyclicThomasSolver.hpp"
+#include "ErrorNorms.hpp"
+#include "MixedPrecisionSolver.hpp"
+#include "ParallelThomasSolver.hpp"
+#include "SolverLog.hpp"
+#include "SolverModel.hpp"
+#include "TimeStepper.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::atomic<long long> g_allocations{0};
+
+} // namespace
+
+// Подсчёт выделений памяти во всей программе
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+struct Options {
+    long long minN = 10;
+    long long maxN = 100000000;
+    double minSeconds = 0.2;     // Минимальное время измерения одного ядра
+    std::string output;          // Пусто — стандартный вывод
+    std::string baseline;        // JSON предыдущего прогона для сравнения
+    double tolerance = 0.15;     // Допустимое замедление относительно базового прогона
+    std::vector<std::string> kernels; // Пусто — все ядра
+    int threads = 4;             // Потоки parallelThomas: не зависят от числа ядер машины
+};
+
+struct Measurement {
+    std::string kernel;
+    long long n;
+    long long iterations;
+    double nsPerNode;
+    double gbPerSecond;
+    double allocationsPerCall;
+    double maxDeviation = -1.0; // max |u - u_thomasAlgorithm| (cyclicThomas: невязка); < 0 — не измеряется
+};
+
+void printUsage() {
+    std::cout <<
+        "Использование: thomasAlgorithmBench [параметры]\n"
+        "  --min-n N         наименьшее n (10)\n"
+        "  --max-n N         наибольшее n (1e8), n растёт в 10 раз\n"
+        "  --min-time S      минимальное время измерения одного ядра, с (0.2)\n"
+        "  --kernels A,B     только перечисленные ядра\n"
+        "  --threads T       потоки parallelThomas (4); разбиение на блоки, если n >= 2^15\n"
+        "  --output FILE     JSON с результатами (по умолчанию стандартный вывод)\n"
+        "  --baseline FILE   сравнить с JSON предыдущего прогона\n"
+        "  --tolerance T     допустимое замедление ns/node, доля (0.15)\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "--help" || key == "-h") {
+            printUsage();
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Не задано значение для " + key);
+        }
+        std::string value = argv[++i];
+        if (key == "--min-n") {
+            options.minN = static_cast<long long>(std::stod(value));
+        } else if (key == "--max-n") {
+            options.maxN = static_cast<long long>(std::stod(value));
+        } else if (key == "--min-time") {
+            options.minSeconds = std::stod(value);
+        } else if (key == "--output") {
+            options.output = value;
+        } else if (key == "--baseline") {
+            options.baseline = value;
+        } else if (key == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else if (key == "--threads") {
+            options.threads = std::stoi(value);
+        } else if (key == "--kernels") {
+            std::istringstream list(value);
+            std::string kernel;
+            while (std::getline(list, kernel, ',')) {
+                options.kernels.push_back(kernel);
+            }
+        } else {
+            throw std::invalid_argument("Неизвестный параметр: " + key);
+        }
+    }
+    if (options.minN < 2 || options.maxN < options.minN) {
+        throw std::invalid_argument("Некорректный диапазон n");
+    }
+    if (options.threads < 1) {
+        throw std::invalid_argument("Число потоков должно быть положительным");
+    }
+    return options;
+}
+
+// Лучшее время одного вызова из серии длительностью не менее minSeconds.
+// bytesPerNode — оценка объёма чтения и записи памяти ядром на один узел
+Measurement measure(const std::string& kernel, long long n, double bytesPerNode,
+                    double minSeconds, const std::function<void()>& body) {
+    using Clock = std::chrono::steady_clock;
+
+    body(); // Прогрев: буферы и кэши разложения
+
+    const long long allocationsBefore = g_allocations.load();
+    long long iterations = 0;
+    double best = std::numeric_limits<double>::max();
+    const Clock::time_point start = Clock::now();
+    do {
+        Clock::time_point begin = Clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - begin).count());
+        ++iterations;
+    } while (std::chrono::duration<double>(Clock::now() - start).count() < minSeconds);
+    const long long allocations = g_allocations.load() - allocationsBefore;
+
+    const double nodes = static_cast<double>(n + 1);
+    return {kernel, n, iterations, best * 1e9 / nodes, bytesPerNode * nodes / best / 1e9,
+            static_cast<double>(allocations) / iterations};
+}
+
+// Матрица тестовой задачи, как в SolverModel::solve
+void buildSystem(int n, std::vector<double>& a, std::vector<double>& b,
+                 std::vector<double>& c, std::vector<double>& d) {
+    const double h = 1.0 / n;
+    a.assign(n + 1, 0.0);
+    b.assign(n + 1, 0.0);
+    c.assign(n + 1, 0.0);
+    d.assign(n + 1, 0.0);
+    for (int i = 1; i < n; ++i) {
+        a[i] = c[i] = 1.0 / (h * h);
+        b[i] = -2.0 / (h * h);
+        d[i] = -M_PI * M_PI * std::sin(M_PI * i * h);
+    }
+    b[0] = b[n] = 1.0;
+}
+
+class Benchmark {
+public:
+    explicit Benchmark(const Options& options) : m_options(options) {}
+
+    void run(int n) {
+        std::vector<double> a, b, c, d, p, u;
+        buildSystem(n, a, b, c, d);
+
+        // Прямой ход: чтение a, b, c, d, запись p, q; обратный: чтение p, q, запись u
+        add("thomasAlgorithm", n, 9 * sizeof(double), [&] {
+            SolverModel::thomasAlgorithm(a, b, c, d, p, u);
+        });
+
+        // Эталон для сравнения точности решателей с тем же интерфейсом
+        std::vector<double> reference;
+        SolverModel::thomasAlgorithm(a, b, c, d, p, reference);
+        // Решение u есть, только если ядро было измерено
+        auto deviation = [&reference](const std::vector<double>& solution) {
+            return [&reference, &solution] {
+                double result = 0.0;
+                for (size_t i = 0; i < reference.size(); ++i) {
+                    result = std::max(result, std::abs(solution[i] - reference[i]));
+                }
+                return result;
+            };
+        };
+
+        ParallelThomasSolver parallelSolver(m_options.threads);
+        add("parallelThomas", n, 9 * sizeof(double), [&] {
+            parallelSolver.solve(a, b, c, d, u);
+        });
+        setDeviation("parallelThomas", deviation(u));
+        if (selected("parallelThomas")) {
+            std::cerr << "    блоков: " << std::max(1, parallelSolver.blocks(static_cast<int>(b.size())));
+            reportSpeedup("thomasAlgorithm");
+        }
+
+        // Объём памяти оценён как у thomasAlgorithm; каждый шаг уточнения добавляет
+        // невязку в double (чтение a, b, c, d, u) и ещё одну прогонку в float
+        MixedPrecisionSolver mixedSolver;
+        add("mixedPrecision", n, 9 * sizeof(double), [&] {
+            mixedSolver.solve(a, b, c, d, u);
+        });
+        setDeviation("mixedPrecision", deviation(u));
+        if (selected("mixedPrecision")) {
+            std::cerr << "    шагов уточнения: " << mixedSolver.lastRefinements()
+                      << (mixedSolver.lastFallback() ? ", решено в double" : "") << "\n";
+        }
+
+        // Периодическая система u_{i-1} - (2 + h^2) u_i + u_{i+1} = d_i с ненулевыми
+        // угловыми элементами; точность — невязка с учётом замыкания, эталона нет.
+        // Прямой ход пишет p, 1/знаменателя и две правые части, обратный и поправка
+        // читают и переписывают u и z
+        if (selected("cyclicThomas")) {
+            const size_t size = a.size();
+            const double h = 1.0 / n;
+            std::vector<double> ca(size, 1.0), cb(size, -2.0 - h * h), cc(size, 1.0), cd(size);
+            for (size_t i = 0; i < size; ++i) {
+                cd[i] = h * h * std::cos(2.0 * M_PI * i / size);
+            }
+            CyclicThomasSolver cyclicSolver;
+            add("cyclicThomas", n, 16 * sizeof(double), [&] {
+                cyclicSolver.solve(ca, cb, cc, cd, u);
+            });
+            setDeviation("cyclicThomas", [&] {
+                double result = 0.0;
+                for (size_t i = 0; i < size; ++i) {
+                    const double left = u[i == 0 ? size - 1 : i - 1];
+                    const double right = u[i + 1 == size ? 0 : i + 1];
+                    result = std::max(result, std::abs(ca[i] * left + cb[i] * u[i] + cc[i] * right - cd[i]));
+                }
+                return result;
+            }, "max |A u - d|");
+        }
+
+        runBlock<2>(n, a, b, c, d, reference);
+        runBlock<3>(n, a, b, c, d, reference);
+        runBlock<4>(n, a, b, c, d, reference);
+
+        // Пакет из 64 разных систем той же суммарной длины. Каждая сверяется
+        // со скалярной thomasAlgorithm: без FMA расхождение должно быть ровно 0
+        const int batch = 64;
+        if (n / batch >= 2) {
+            const int size = n / batch;
+            std::vector<double> ba(static_cast<size_t>(size) * batch, 1.0);
+            std::vector<double> bb(ba.size());
+            std::vector<double> bc(ba.size(), 1.0);
+            std::vector<double> bd(ba.size());
+            std::vector<double> bu(ba.size());
+            for (int i = 0; i < size; ++i) {
+                for (int s = 0; s < batch; ++s) {
+                    bb[static_cast<size_t>(i) * batch + s] = -2.5 - 0.01 * s;
+                    bd[static_cast<size_t>(i) * batch + s] = std::sin(0.1 * i + s);
+                }
+            }
+            BatchThomasSolver batchSolver(size, batch);
+            add("batchThomas", static_cast<long long>(size) * batch - 1, 8 * sizeof(double), [&] {
+                batchSolver.solve(ba.data(), bb.data(), bc.data(), bd.data(), bu.data());
+            });
+            setDeviation("batchThomas", [&] {
+                std::vector<double> la(size), lb(size), lc(size), ld(size), lp, lu;
+                double result = 0.0;
+                for (int s = 0; s < batch; ++s) {
+                    for (int i = 0; i < size; ++i) {
+                        const size_t index = static_cast<size_t>(i) * batch + s;
+                        la[i] = ba[index];
+                        lb[i] = bb[index];
+                        lc[i] = bc[index];
+                        ld[i] = bd[index];
+                    }
+                    SolverModel::thomasAlgorithm(la, lb, lc, ld, lp, lu);
+                    for (int i = 0; i < size; ++i) {
+                        result = std::max(result, std::abs(bu[static_cast<size_t>(i) * batch + s] - lu[i]));
+                    }
+                }
+                return result;
+            });
+        }
+
+        runAdi(2, n);
+        runAdi(3, n);
+
+        SolverModel model;
+        model.setParams({0.0, 0.0, 0.5, n, 1e-6});
+
+        // Сборка матрицы и прямой ход по ней: запись и чтение a, b, c, запись p и 1/знаменателя
+        add("factorize", n, 8 * sizeof(double), [&] {
+            model.factorize();
+        });
+
+        // Полное решение при готовом разложении: правая часть, прогонка, ошибка
+        // (узлы и аналитическое решение не хранятся)
+        SolverModel::Result result;
+        add("solve", n, 12 * sizeof(double), [&] {
+            model.solve(result);
+        });
+
+        // Сборка совмещена с прямым ходом (Method::Fused): запись p и q, обратный ход
+        // читает их и пишет u. В отличие от solve, разложение строится при каждом вызове
+        SolverModel fusedModel;
+        fusedModel.setParams({0.0, 0.0, 0.5, n, 1e-6, SolverModel::Method::Fused});
+        SolverModel::Result fusedResult;
+        add("fused", n, 5 * sizeof(double), [&] {
+            fusedModel.solve(fusedResult);
+        });
+        setDeviation("fused", deviation(fusedResult.u));
+
+        // Для сравнения с fused на равных: путь Thomas при новом n на каждом вызове
+        // (n и n - 1 чередуются), так что разложение и кэш f строятся заново.
+        // Сборка a, b, c и f, правая часть d, прямой ход (p и 1/знаменателя),
+        // прогонка по разложению с записью u
+        if (selected("solveFresh")) {
+            SolverModel freshModel;
+            SolverModel::Result freshResult;
+            bool odd = false;
+            add("solveFresh", n, 16 * sizeof(double), [&] {
+                odd = !odd;
+                freshModel.setParams({0.0, 0.0, 0.5, odd ? n - 1 : n, 1e-6});
+                freshModel.solve(freshResult);
+            });
+        }
+
+        // Шаг Кранка — Николсон по готовому разложению: прямой ход читает u, коэффициенты
+        // явной части и разложения (7 массивов), пишет q; обратный читает p, q, u и пишет u
+        if (selected("timeStep")) {
+            TimeStepper stepper(std::make_shared<PolicyKernels<SinProblem>>());
+            std::vector<double> state;
+            TimeStepper::Options once;
+            once.steps = 0;
+            stepper.run(n, 0.0, 0.0, state, once);
+            add("timeStep", n, 12 * sizeof(double), [&] {
+                stepper.step(state);
+            });
+        }
+
+        // Аналитическое решение вычисляется внутри, из памяти читается только u
+        add("calculateError", n, sizeof(double), [&] {
+            volatile double error = model.calculateError(result.u, result.analytical);
+            (void)error;
+        });
+
+        // Все нормы за один проход: чтение u, аналитическое решение вычисляется на лету
+        add("errorNorms", n, sizeof(double), [&] {
+            volatile double error = computeErrorNorms(result.x, result.u, result.analytical).l2Error;
+            (void)error;
+        });
+
+        if (n % 2 == 0 && selected("calculateGridError")) {
+            SolverModel::Result coarse;
+            model.setParams({0.0, 0.0, 0.5, n / 2, 1e-6});
+            model.solve(coarse);
+            // Чтение u грубой сетки и через узел мелкой (полные кэш-линии)
+            add("calculateGridError", n / 2, 3 * sizeof(double), [&] {
+                volatile double error = model.calculateGridError(coarse, result);
+                (void)error;
+            });
+        }
+
+        // Полный цикл сгущения от n = 10 до первого уровня не меньше n
+        if (selected("solveWithAccuracy")) {
+            int finalN = 10;
+            while (finalN < n) {
+                finalN *= 2;
+            }
+            model.setParams({0.0, 0.0, 0.5, finalN, 1e-6});
+            model.solve(result);
+            const double target = result.maxError * (1.0 + 1e-9);
+            model.setParams({0.0, 0.0, 0.5, 10, target});
+            SolverModel::Result accuracyResult = model.solveWithAccuracy(target);
+            const long long reachedN = static_cast<long long>(accuracyResult.x.size()) - 1;
+            add("solveWithAccuracy", reachedN, 30 * sizeof(double), [&] {
+                accuracyResult = model.solveWithAccuracy(target);
+            });
+        }
+    }
+
+    const std::vector<Measurement>& measurements() const { return m_measurements; }
+
+private:
+    // Матричная прогонка по N независимым копиям тестовой системы (диагональные
+    // блоки): арифметика та же, что для связанных блоков, а каждая компонента
+    // решения совпадает с эталоном. Чтение A, B, C, D, запись P и Q, обратный ход
+    // читает P, Q и пишет U — на блочную строку
+    template <int N>
+    void runBlock(int n, const std::vector<double>& a, const std::vector<double>& b,
+                  const std::vector<double>& c, const std::vector<double>& d,
+                  const std::vector<double>& reference) {
+        const std::string kernel = "blockThomas" + std::to_string(N);
+        if (!selected(kernel)) {
+            return;
+        }
+        const size_t rows = a.size();
+        std::vector<double> ba(rows * N * N, 0.0), bb(ba.size(), 0.0), bc(ba.size(), 0.0);
+        std::vector<double> bd(rows * N), bu;
+        for (size_t i = 0; i < rows; ++i) {
+            for (int k = 0; k < N; ++k) {
+                const size_t diagonal = i * N * N + k * N + k;
+                ba[diagonal] = a[i];
+                bb[diagonal] = b[i];
+                bc[diagonal] = c[i];
+                bd[i * N + k] = d[i];
+            }
+        }
+        BlockThomasSolver<N> solver;
+        add(kernel, n, (5 * N * N + 4 * N) * sizeof(double), [&] {
+            solver.solve(ba, bb, bc, bd, bu);
+        });
+        setDeviation(kernel, [&] {
+            double result = 0.0;
+            for (size_t i = 0; i < bu.size(); ++i) {
+                result = std::max(result, std::abs(bu[i] - reference[i / N]));
+            }
+            return result;
+        });
+    }
+
+    // Шаг ADI на квадрате или кубе примерно из n узлов. Копия u, правая часть
+    // первого полушага (чтение u и f, запись u), остальные полушаги читают u
+    // и начальное u, пишут u
+    void runAdi(int dimensions, int n) {
+        const std::string kernel = "adi" + std::to_string(dimensions) + "d";
+        const int side = static_cast<int>(std::lround(std::pow(n + 1.0, 1.0 / dimensions))) - 1;
+        if (!selected(kernel) || side < 8) {
+            return;
+        }
+        AdiSolver solver(dimensions, side);
+        std::vector<double> u(solver.nodes(), 0.0);
+        std::vector<double> f(solver.nodes(), 1.0);
+        add(kernel, static_cast<long long>(solver.nodes()) - 1, (3 * dimensions + 2) * sizeof(double), [&] {
+            solver.step(u, f, 1e-3);
+        });
+    }
+
+    bool selected(const std::string& kernel) const {
+        return m_options.kernels.empty() ||
+               std::find(m_options.kernels.begin(), m_options.kernels.end(), kernel) != m_options.kernels.end();
+    }
+
+    // Точность последнего измеренного ядра относительно thomasAlgorithm
+    void setDeviation(const std::string& kernel, const std::function<double()>& computeDeviation,
+                      const char* label = "max |u - u_thomas|") {
+        if (!selected(kernel)) {
+            return;
+        }
+        const double deviation = computeDeviation();
+        m_measurements.back().maxDeviation = deviation;
+        std::cerr << "    " << label << " = " << deviation << "\n";
+    }
+
+    // Ускорение последнего измеренного ядра относительно base при том же n
+    void reportSpeedup(const std::string& base) const {
+        const Measurement& m = m_measurements.back();
+        for (const Measurement& other : m_measurements) {
+            if (other.kernel == base && other.n == m.n) {
+                std::cerr << ", ускорение относительно " << base << ": "
+                          << std::setprecision(3) << other.nsPerNode / m.nsPerNode;
+                break;
+            }
+        }
+        std::cerr << "\n";
+    }
+
+    void add(const std::string& kernel, long long n, double bytesPerNode, const std::function<void()>& body) {
+        if (!selected(kernel)) {
+            return;
+        }
+        m_measurements.push_back(measure(kernel, n, bytesPerNode, m_options.minSeconds, body));
+        const Measurement& m = m_measurements.back();
+        std::cerr << std::left << std::setw(20) << kernel << " n=" << std::setw(10) << n
+                  << std::fixed << std::setprecision(3) << std::right << std::setw(10) << m.nsPerNode << " ns/node"
+                  << std::setw(9) << m.gbPerSecond << " GB/s"
+                  << std::setw(8) << std::setprecision(1) << m.allocationsPerCall << " alloc/call\n";
+        std::cerr.unsetf(std::ios::floatfield);
+    }
+
+    const Options& m_options;
+    std::vector<Measurement> m_measurements;
+};
+
+void writeJson(std::ostream& out, const std::vector<Measurement>& measurements) {
+    // Одна запись на строку: формат читается обратно в readBaseline
+    out << "{\n  \"isa\": \"" << BatchThomasSolver::instructionSet() << "\",\n  \"results\": [\n";
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        const Measurement& m = measurements[i];
+        out << "    {\"kernel\": \"" << m.kernel << "\", \"n\": " << m.n
+            << ", \"iterations\": " << m.iterations
+            << std::setprecision(6) << ", \"ns_per_node\": " << m.nsPerNode
+            << ", \"gb_per_s\": " << m.gbPerSecond
+            << ", \"allocations_per_call\": " << m.allocationsPerCall;
+        if (m.maxDeviation >= 0.0) {
+            out << ", \"max_deviation\": " << m.maxDeviation;
+        }
+        out << "}"
+            << (i + 1 < measurements.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Значение поля "key": из строки записи, сформированной writeJson
+std::string jsonField(const std::string& line, const std::string& key) {
+    const std::string pattern = "\"" + key + "\": ";
+    size_t position = line.find(pattern);
+    if (position == std::string::npos) {
+        return {};
+    }
+    position += pattern.size();
+    if (line[position] == '"') {
+        return line.substr(position + 1, line.find('"', position + 1) - position - 1);
+    }
+    return line.substr(position, line.find_first_of(",}", position) - position);
+}
+
+std::map<std::pair<std::string, long long>, double> readBaseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть базовый прогон " + path);
+    }
+    std::map<std::pair<std::string, long long>, double> baseline;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string kernel = jsonField(line, "kernel");
+        if (!kernel.empty()) {
+            baseline[{kernel, std::stoll(jsonField(line, "n"))}] = std::stod(jsonField(line, "ns_per_node"));
+        }
+    }
+    return baseline;
+}
+
+// Число ядер, замедлившихся больше допустимого
+int compareWithBaseline(const std::vector<Measurement>& measurements, const Options& options) {
+    const auto baseline = readBaseline(options.baseline);
+    int regressions = 0;
+    for (const Measurement& m : measurements) {
+        auto it = baseline.find({m.kernel, m.n});
+        if (it == baseline.end()) {
+            continue;
+        }
+        const double ratio = m.nsPerNode / it->second;
+        if (ratio > 1.0 + options.tolerance) {
+            std::cerr << "Регрессия: " << m.kernel << " n=" << m.n << " медленнее в "
+                      << std::setprecision(3) << ratio << " раза\n";
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseArguments(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    // Журнал итераций solveWithAccuracy искажает измерения
+    setSolverLogLevel(SolverLogLevel::Warning);
+
+    Benchmark benchmark(options);
+    try {
+        for (long long n = options.minN; n <= options.maxN; n *= 10) {
+            benchmark.run(static_cast<int>(n));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << '\n';
+        return 1;
+    }
+
+    if (options.output.empty()) {
+        writeJson(std::cout, benchmark.measurements());
+    } else {
+        std::ofstream file(options.output);
+        writeJson(file, benchmark.measurements());
+    }
+
+    if (!options.baseline.empty()) {
+        try {
+            return compareWithBaseline(benchmark.measurements(), options) == 0 ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Ошибка: " << e.what() << '\n';
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "SolverCApi.h"
+#include "SolverLog.hpp"
+#include "SolverModel.hpp"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct thomas_solver {
+    SolverModel model;
+    SolverModel::Params params{0.0, 0.0, 0.5, 10, 1e-6}; // Как в SolverModel::SolverModel
+    SolverModel::Result result;
+    std::string lastError;
+};
+
+namespace {
+
+// Исключение ядра превращается в код -1 и текст ошибки решателя
+template <typename Action>
+int guarded(thomas_solver* solver, Action action) {
+    if (!solver) {
+        return -1;
+    }
+    try {
+        solver->lastError.clear();
+        action();
+        return 0;
+    } catch (const std::exception& e) {
+        solver->lastError = e.what();
+    } catch (...) {
+        solver->lastError = "Неизвестная ошибка";
+    }
+    return -1;
+}
+
+thomas_log_sink logSink = nullptr;
+
+void forwardLog(SolverLogLevel level, const char* message, void* context) {
+    logSink(static_cast<thomas_log_level>(level), message, context);
+}
+
+} // namespace
+
+void thomas_set_log_sink(thomas_log_sink sink, void* context) {
+    // Приёмник ядра вызывается под блокировкой, поэтому logSink меняется до его установки
+    setSolverLogSink(nullptr);
+    logSink = sink;
+    setSolverLogSink(sink ? forwardLog : nullptr, context);
+}
+
+void thomas_set_log_level(thomas_log_level level) {
+    setSolverLogLevel(static_cast<SolverLogLevel>(std::min(std::max(static_cast<int>(level), 0),
+                                                          static_cast<int>(SolverLogLevel::Off))));
+}
+
+thomas_solver* thomas_solver_create(const char* problem) {
+    try {
+        thomas_solver* solver = new thomas_solver();
+        if (problem && std::strcmp(problem, "layer") == 0) {
+            solver->model.setProblem<LayerProblem>();
+        } else if (problem && std::strcmp(problem, "sin") != 0) {
+            delete solver;
+            return nullptr;
+        }
+        return solver;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void thomas_solver_destroy(thomas_solver* solver) {
+    delete solver;
+}
+
+const char* thomas_solver_last_error(const thomas_solver* solver) {
+    return solver ? solver->lastError.c_str() : "";
+}
+
+int thomas_solver_set_params(thomas_solver* solver, double mu1, double mu2, double xi, int n, double epsilon) {
+    return guarded(solver, [&] {
+        SolverModel::Params params{mu1, mu2, xi, n, epsilon};
+        params.method = solver->params.method;
+        params.threads = solver->params.threads;
+        solver->model.setParams(params);
+        solver->params = params;
+    });
+}
+
+int thomas_solver_set_method(thomas_solver* solver, thomas_method method, int threads) {
+    return guarded(solver, [&] {
+        SolverModel::Params params = solver->params;
+        switch (method) {
+        case THOMAS_METHOD_THOMAS: params.method = SolverModel::Method::Thomas; break;
+        case THOMAS_METHOD_PARALLEL: params.method = SolverModel::Method::Parallel; break;
+        case THOMAS_METHOD_MIXED: params.method = SolverModel::Method::MixedPrecision; break;
+        case THOMAS_METHOD_FUSED: params.method = SolverModel::Method::Fused; break;
+        default: throw std::invalid_argument("Неизвестный метод решения");
+        }
+        params.threads = threads;
+        solver->model.setParams(params);
+        solver->params = params;
+    });
+}
+
+int thomas_solver_solve(thomas_solver* solver) {
+    return guarded(solver, [&] { solver->model.solve(solver->result); });
+}
+
+int thomas_solver_solve_with_accuracy(thomas_solver* solver, double target_error) {
+    return guarded(solver, [&] { solver->result = solver->model.solveWithAccuracy(target_error); });
+}
+
+size_t thomas_solver_size(const thomas_solver* solver) {
+    return solver ? solver->result.u.size() : 0;
+}
+
+int thomas_solver_copy_solution(thomas_solver* solver, double* x, double* u, size_t count) {
+    return guarded(solver, [&] {
+        const SolverModel::Result& result = solver->result;
+        if (!u || count < result.u.size()) {
+            throw std::invalid_argument("Буфер меньше числа узлов решения");
+        }
+        std::copy(result.u.begin(), result.u.end(), u);
+        if (x) {
+            result.x.copy(0, result.x.size(), x);
+        }
+    });
+}
+
+double thomas_solver_max_error(const thomas_solver* solver) {
+    return solver ? solver->result.maxError : 0.0;
+}
+
+int thomas_solve_tridiagonal(size_t n, const double* a, const double* b, const double* c,
+                             const double* d, double* u) {
+    if (n == 0 || !a || !b || !c || !d || !u) {
+        return -1;
+    }
+    try {
+        std::vector<double> p;
+        std::vector<double> solution;
+        SolverModel::thomasAlgorithm(std::vector<double>(a, a + n), std::vector<double>(b, b + n),
+                                     std::vector<double>(c, c + n), std::vector<double>(d, d + n),
+                                     p, solution);
+        std::copy(solution.begin(), solution.end(), u);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+/* C-интерфейс численного ядра для подключения из других языков и служб.
+ * Исключения ядра не выходят за его пределы: функции возвращают 0 при успехе
+ * и -1 при ошибке, текст которой возвращает thomas_solver_last_error.
+ * Один объект решателя нельзя использовать из нескольких потоков одновременно. */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct thomas_solver thomas_solver;
+
+typedef enum {
+    THOMAS_METHOD_THOMAS = 0,   /* Последовательная прогонка */
+    THOMAS_METHOD_PARALLEL = 1, /* Метод разбиения, threads потоков (0 — по числу ядер) */
+    THOMAS_METHOD_MIXED = 2,    /* float с уточнением в double */
+    THOMAS_METHOD_FUSED = 3     /* Сборка и прогонка за один проход */
+} thomas_method;
+
+/* Значения совпадают с SolverLogLevel */
+typedef enum {
+    THOMAS_LOG_DEBUG = 0,
+    THOMAS_LOG_INFO = 1,
+    THOMAS_LOG_WARNING = 2,
+    THOMAS_LOG_ERROR = 3,
+    THOMAS_LOG_OFF = 4
+} thomas_log_level;
+
+typedef void (*thomas_log_sink)(thomas_log_level level, const char* message, void* context);
+
+/* Журнал ядра: приёмник (NULL — stderr) и порог, общие для всего процесса */
+void thomas_set_log_sink(thomas_log_sink sink, void* context);
+void thomas_set_log_level(thomas_log_level level);
+
+/* problem: "sin" или "layer" (NULL — "sin"); NULL при неизвестной задаче */
+thomas_solver* thomas_solver_create(const char* problem);
+void thomas_solver_destroy(thomas_solver* solver);
+
+/* Текст последней ошибки; пустая строка, если её не было. Действителен до следующего вызова */
+const char* thomas_solver_last_error(const thomas_solver* solver);
+
+/* xi для "layer" не действует: слой всегда в точке 0.5 */
+int thomas_solver_set_params(thomas_solver* solver, double mu1, double mu2, double xi, int n, double epsilon);
+int thomas_solver_set_method(thomas_solver* solver, thomas_method method, int threads);
+
+/* Решение на сетке из n разбиений */
+int thomas_solver_solve(thomas_solver* solver);
+/* Удвоение сетки от n до достижения target_error */
+int thomas_solver_solve_with_accuracy(thomas_solver* solver, double target_error);
+
+/* Последний результат: число узлов, узлы и решение в буферы из count значений
+ * (x может быть NULL), максимальная ошибка относительно аналитического решения */
+size_t thomas_solver_size(const thomas_solver* solver);
+int thomas_solver_copy_solution(thomas_solver* solver, double* x, double* u, size_t count);
+double thomas_solver_max_error(const thomas_solver* solver);
+
+/* Прогонка одной системы: a_i u_{i-1} + b_i u_i + c_i u_{i+1} = d_i, i = 0..n-1
+ * (a_0 и c_{n-1} не используются) */
+int thomas_solve_tridiagonal(size_t n, const double* a, const double* b, const double* c,
+                             const double* d, double* u);
+
+#ifdef __cplusplus
+}
+#endif
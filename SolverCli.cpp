@@ -0,0 +1,511 @@
+// Консольный пакетный запуск решателя: параметры задаются в командной строке
+// или в файле заданий, сводка и решения пишутся в CSV или двоичные файлы.
+#include "ResultCache.hpp"
+#include "ResultFile.hpp"
+#include "SolverLog.hpp"
+#include "SolverModel.hpp"
+#include "SweepEngine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Job {
+    enum class Mode { Accuracy, Solve, Adaptive, Transient };
+
+    SolverModel::Params params{0.0, 0.0, 0.5, 10, 1e-6};
+    Mode mode = Mode::Accuracy;
+    std::string problem = "sin";
+    TimeStepper::Options transient; // Для Mode::Transient; snapshotPath задаётся по --solution
+};
+
+struct Options {
+    std::vector<Job> jobs;
+    std::string output;         // Сводка; пусто — стандартный вывод
+    std::string solutionPrefix; // Решения по заданиям: <prefix>_<номер>.csv/.bin
+    std::string timingsPath;    // JSON-строка на задание со временем фаз по уровням
+    std::string format = "csv";
+    bool verbose = false;
+
+    // Перебор пространства параметров (SweepEngine) вместо списка заданий
+    std::string sweep;
+    int workers = 0;
+    Job defaults;
+
+    // Кэш результатов между заданиями (ResultCache), мегабайты; 0 — без кэша
+    size_t cacheMegabytes = 0;
+};
+
+void printUsage() {
+    std::cout <<
+        "Использование: thomasAlgorithmCli [параметры]\n"
+        "  --n N                число разбиений (по умолчанию 10)\n"
+        "  --epsilon E          целевая точность (1e-6)\n"
+        "  --mu1 V, --mu2 V     граничные условия (0)\n"
+        "  --xi V               точка разрыва (0.5); в adaptive — узел начальной сетки.\n"
+        "                       Для layer не действует: xi = 0.5, положение слоя\n"
+        "  --method M           thomas | parallel | mixed | fused\n"
+        "  --refinements K      шаги уточнения в double для mixed (3)\n"
+        "  --threads T          потоки для parallel (0 — по числу ядер)\n"
+        "  --richardson 0|1     экстраполяция Ричардсона\n"
+        "  --mode M             accuracy (solveWithAccuracy) | solve | adaptive (solveAdaptive) |\n"
+        "                       transient (u_t = k u'' - q u + f от линейного начального условия)\n"
+        "  --scheme S           схема для transient: cn (Кранк — Николсон) | be (неявная Эйлера)\n"
+        "  --tau T, --steps K   шаг по времени (1e-3) и число шагов (1000) для transient\n"
+        "  --snapshot-every K   снимок каждые K шагов в <PREFIX>_<номер>_snapshots.bin\n"
+        "                       (записи t, u_0..u_n в double); 0 — начальный и конечный\n"
+        "  --problem P          sin | layer (крутой слой в точке 0.5)\n"
+        "  --job FILE           файл заданий: строка — набор ключ=значение с теми же ключами,\n"
+        "                       значения из командной строки служат умолчаниями\n"
+        "  --output FILE        файл сводки (по умолчанию стандартный вывод)\n"
+        "  --solution PREFIX    сохранить решение каждого задания\n"
+        "  --format F           csv | binary (x, u, analytical подряд, double) |\n"
+        "                       result (.res: параметры, сводка и массивы .npy, см. ResultFile.hpp)\n"
+        "  --timings FILE       время фаз по уровням сгущения, JSON-строка на задание\n"
+        "  --sweep SPEC         перебор solveWithAccuracy по декартову произведению значений,\n"
+        "                       например mu1=0,1;xi=0.3,0.5;epsilon=1e-4,1e-6\n"
+        "  --workers T          потоки перебора (0 — по числу ядер)\n"
+        "  --cache-mb M         кэш результатов объёмом M МБ: задания и конфигурации перебора\n"
+        "                       с общими параметрами не пересчитывают решённые сетки\n"
+        "  --verbose            выводить журнал итераций\n";
+}
+
+// Применение пары ключ=значение к заданию
+void applyOption(Job& job, const std::string& key, const std::string& value) {
+    SolverModel::Params& params = job.params;
+    if (key == "n") {
+        params.n = std::stoi(value);
+    } else if (key == "epsilon") {
+        params.epsilon = std::stod(value);
+    } else if (key == "mu1") {
+        params.mu1 = std::stod(value);
+    } else if (key == "mu2") {
+        params.mu2 = std::stod(value);
+    } else if (key == "xi") {
+        params.xi = std::stod(value);
+    } else if (key == "threads") {
+        params.threads = std::stoi(value);
+    } else if (key == "refinements") {
+        params.refinements = std::stoi(value);
+    } else if (key == "richardson") {
+        params.richardson = std::stoi(value) != 0;
+    } else if (key == "method") {
+        if (value == "thomas") {
+            params.method = SolverModel::Method::Thomas;
+        } else if (value == "parallel") {
+            params.method = SolverModel::Method::Parallel;
+        } else if (value == "mixed") {
+            params.method = SolverModel::Method::MixedPrecision;
+        } else if (value == "fused") {
+            params.method = SolverModel::Method::Fused;
+        } else {
+            throw std::invalid_argument("Неизвестный метод: " + value);
+        }
+    } else if (key == "mode") {
+        if (value == "accuracy") {
+            job.mode = Job::Mode::Accuracy;
+        } else if (value == "solve") {
+            job.mode = Job::Mode::Solve;
+        } else if (value == "adaptive") {
+            job.mode = Job::Mode::Adaptive;
+        } else if (value == "transient") {
+            job.mode = Job::Mode::Transient;
+        } else {
+            throw std::invalid_argument("Неизвестный режим: " + value);
+        }
+    } else if (key == "scheme") {
+        if (value == "cn") {
+            job.transient.scheme = TimeStepper::Scheme::CrankNicolson;
+        } else if (value == "be") {
+            job.transient.scheme = TimeStepper::Scheme::BackwardEuler;
+        } else {
+            throw std::invalid_argument("Неизвестная схема: " + value);
+        }
+    } else if (key == "tau") {
+        job.transient.tau = std::stod(value);
+    } else if (key == "steps") {
+        job.transient.steps = std::stoll(value);
+    } else if (key == "snapshot-every") {
+        job.transient.snapshotEvery = std::stoll(value);
+    } else if (key == "problem") {
+        if (value != "sin" && value != "layer") {
+            throw std::invalid_argument("Неизвестная задача: " + value);
+        }
+        job.problem = value;
+    } else {
+        throw std::invalid_argument("Неизвестный параметр: " + key);
+    }
+}
+
+std::vector<Job> readJobFile(const std::string& path, const Job& defaults) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл заданий " + path);
+    }
+
+    std::vector<Job> jobs;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream tokens(line);
+        std::string token;
+        Job job = defaults;
+        bool empty = true;
+        while (tokens >> token) {
+            size_t separator = token.find('=');
+            if (separator == std::string::npos) {
+                throw std::invalid_argument(path + ":" + std::to_string(lineNumber) +
+                                            ": ожидается ключ=значение, получено " + token);
+            }
+            applyOption(job, token.substr(0, separator), token.substr(separator + 1));
+            empty = false;
+        }
+        if (!empty) {
+            jobs.push_back(job);
+        }
+    }
+    return jobs;
+}
+
+Options parseArguments(int argc, char* argv[]) {
+    Options options;
+    Job defaults;
+    std::string jobFile;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help" || argument == "-h") {
+            printUsage();
+            std::exit(0);
+        }
+        if (argument == "--verbose") {
+            options.verbose = true;
+            continue;
+        }
+        if (argument.compare(0, 2, "--") != 0) {
+            throw std::invalid_argument("Неизвестный аргумент: " + argument);
+        }
+
+        // --ключ=значение или --ключ значение
+        std::string key = argument.substr(2);
+        std::string value;
+        size_t separator = key.find('=');
+        if (separator != std::string::npos) {
+            value = key.substr(separator + 1);
+            key = key.substr(0, separator);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            throw std::invalid_argument("Не задано значение для --" + key);
+        }
+
+        if (key == "job") {
+            jobFile = value;
+        } else if (key == "output") {
+            options.output = value;
+        } else if (key == "solution") {
+            options.solutionPrefix = value;
+        } else if (key == "timings") {
+            options.timingsPath = value;
+        } else if (key == "sweep") {
+            options.sweep = value;
+        } else if (key == "workers") {
+            options.workers = std::stoi(value);
+        } else if (key == "cache-mb") {
+            options.cacheMegabytes = std::stoul(value);
+        } else if (key == "format") {
+            if (value != "csv" && value != "binary" && value != "result") {
+                throw std::invalid_argument("Неизвестный формат: " + value);
+            }
+            options.format = value;
+        } else {
+            applyOption(defaults, key, value);
+        }
+    }
+
+    options.defaults = defaults;
+    if (jobFile.empty()) {
+        options.jobs.push_back(defaults);
+    } else {
+        options.jobs = readJobFile(jobFile, defaults);
+    }
+    return options;
+}
+
+// mu1=0,1;xi=0.3,0.5 — списки значений по осям пространства параметров
+ParameterSpace parseSweep(const std::string& spec, const SolverModel::Params& base) {
+    ParameterSpace space;
+    space.base = base;
+
+    std::istringstream axes(spec);
+    std::string axis;
+    while (std::getline(axes, axis, ';')) {
+        if (axis.empty()) {
+            continue;
+        }
+        size_t separator = axis.find('=');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("Ожидается ключ=значения, получено " + axis);
+        }
+        const std::string key = axis.substr(0, separator);
+        std::vector<double>* values = key == "mu1" ? &space.mu1
+                                    : key == "mu2" ? &space.mu2
+                                    : key == "xi" ? &space.xi
+                                    : key == "epsilon" ? &space.epsilon
+                                    : nullptr;
+        if (!values) {
+            throw std::invalid_argument("Параметр перебора не поддерживается: " + key);
+        }
+        std::istringstream list(axis.substr(separator + 1));
+        std::string value;
+        while (std::getline(list, value, ',')) {
+            values->push_back(std::stod(value));
+        }
+    }
+    return space;
+}
+
+int runSweep(const Options& options, std::ostream& out) {
+    ParameterSpace space = parseSweep(options.sweep, options.defaults.params);
+    SolverModel prototype;
+    if (options.defaults.problem == "layer") {
+        prototype.setProblem<LayerProblem>();
+    }
+    prototype.setParams(space.base);
+    if (options.cacheMegabytes > 0) {
+        prototype.setCache(std::make_shared<ResultCache>(options.cacheMegabytes << 20));
+    }
+
+    int failures = 0;
+    out << std::setprecision(17) << "index,mu1,mu2,xi,epsilon,final_n,levels,max_error,seconds,worker,error\n";
+    SweepEngine engine(options.workers);
+    SweepEngine::Stats stats = engine.run(prototype, space, [&](const SweepResult& result) {
+        const SolverModel::Params& params = result.params;
+        out << result.index << ',' << params.mu1 << ',' << params.mu2 << ',' << params.xi << ','
+            << params.epsilon << ',' << result.finalN << ',' << result.convergenceData.size() << ','
+            << result.maxError << ',' << result.seconds << ',' << result.worker << ',' << result.error << '\n';
+        if (!result.error.empty()) {
+            ++failures;
+        }
+    });
+
+    std::cerr << "Конфигураций: " << space.size() << ", потоков: " << stats.tasks.size()
+              << ", захватов работы: " << stats.steals << '\n';
+    return failures == 0 ? 0 : 1;
+}
+
+void writeSolution(const std::string& path, const std::string& format, const SolverModel::Result& result) {
+    if (format == "binary") {
+        std::ofstream file(path, std::ios::binary);
+        // x и аналитическое решение вычисляются блоками по мере записи
+        const size_t block = 4096;
+        std::vector<double> buffer(block);
+        auto writeBlock = [&](size_t count) {
+            file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(count * sizeof(double)));
+        };
+        for (size_t first = 0; first < result.x.size(); first += block) {
+            const size_t count = std::min(block, result.x.size() - first);
+            result.x.copy(first, count, buffer.data());
+            writeBlock(count);
+        }
+        file.write(reinterpret_cast<const char*>(result.u.data()),
+                   static_cast<std::streamsize>(result.u.size() * sizeof(double)));
+        for (size_t first = 0; first < result.analytical.size(); first += block) {
+            const size_t count = std::min(block, result.analytical.size() - first);
+            result.analytical.evaluate(first, count, buffer.data());
+            writeBlock(count);
+        }
+        if (!file) {
+            throw std::runtime_error("Ошибка записи " + path);
+        }
+        return;
+    }
+
+    std::ofstream file(path);
+    file << std::setprecision(17) << "x,u,analytical\n";
+    for (size_t i = 0; i < result.x.size(); ++i) {
+        file << result.x[i] << ',' << result.u[i] << ','
+             << (i < result.analytical.size() ? result.analytical[i] : std::numeric_limits<double>::quiet_NaN()) << '\n';
+    }
+    if (!file) {
+        throw std::runtime_error("Ошибка записи " + path);
+    }
+}
+
+const char* methodName(SolverModel::Method method) {
+    switch (method) {
+    case SolverModel::Method::Parallel: return "parallel";
+    case SolverModel::Method::MixedPrecision: return "mixed";
+    case SolverModel::Method::Fused: return "fused";
+    case SolverModel::Method::Thomas: break;
+    }
+    return "thomas";
+}
+
+const char* modeName(Job::Mode mode) {
+    switch (mode) {
+    case Job::Mode::Solve: return "solve";
+    case Job::Mode::Adaptive: return "adaptive";
+    case Job::Mode::Transient: return "transient";
+    case Job::Mode::Accuracy: break;
+    }
+    return "accuracy";
+}
+
+// Интегрирование по времени: в сводке levels — число шагов, max_error — отличие
+// от стационарного аналитического решения, время по фазам не измеряется
+void runTransient(SolverModel& model, const Job& job, size_t index, const Options& options, std::ostream& out) {
+    const SolverModel::Params& params = job.params;
+    TimeStepper::Options transient = job.transient;
+    if (!options.solutionPrefix.empty()) {
+        transient.snapshotPath = options.solutionPrefix + "_" + std::to_string(index) + "_snapshots.bin";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> u;
+    TimeStepper::Summary summary = model.solveTransient(u, transient);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    out << index << ',' << params.mu1 << ',' << params.mu2 << ',' << params.xi << ','
+        << params.n << ',' << params.epsilon << ',' << methodName(params.method) << ','
+        << params.richardson << ',' << modeName(job.mode) << ',' << job.problem << ','
+        << params.n << ',' << summary.steps << ',' << summary.stationaryError << ',' << seconds;
+    for (int phase = 0; phase < PhaseTimings::phaseCount; ++phase) {
+        out << ",0";
+    }
+    out << '\n';
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseArguments(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка: " << e.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    // Журнал итераций solveWithAccuracy выводится в stderr только с --verbose
+    setSolverLogLevel(options.verbose ? SolverLogLevel::Debug : SolverLogLevel::Warning);
+
+    std::ofstream outputFile;
+    if (!options.output.empty()) {
+        outputFile.open(options.output);
+        if (!outputFile) {
+            std::cerr << "Не удалось открыть " << options.output << '\n';
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : outputFile;
+    if (!options.sweep.empty()) {
+        try {
+            return runSweep(options, out);
+        } catch (const std::exception& e) {
+            std::cerr << "Ошибка: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    // Время по фазам (SolverProfiler) суммируется по уровням сгущения, в секундах
+    out << std::setprecision(17)
+        << "job,mu1,mu2,xi,n,epsilon,method,richardson,mode,problem,final_n,levels,max_error,seconds";
+    for (int phase = 0; phase < PhaseTimings::phaseCount; ++phase) {
+        out << ",t_" << PhaseTimings::phaseName(static_cast<SolverPhase>(phase));
+    }
+    out << '\n';
+
+    std::ofstream timingsFile;
+    if (!options.timingsPath.empty()) {
+        timingsFile.open(options.timingsPath);
+        if (!timingsFile) {
+            std::cerr << "Не удалось открыть " << options.timingsPath << '\n';
+            return 1;
+        }
+    }
+
+    SolverModel model;
+    if (options.cacheMegabytes > 0) {
+        model.setCache(std::make_shared<ResultCache>(options.cacheMegabytes << 20));
+    }
+    int failures = 0;
+    for (size_t index = 0; index < options.jobs.size(); ++index) {
+        const Job& job = options.jobs[index];
+        SolverModel::Params params = job.params;
+        try {
+            if (job.problem == "layer") {
+                // Начальный узел адаптивной сетки ставится в слой, а не в заданное xi
+                if (params.xi != LayerProblem::xi) {
+                    std::cerr << "Задание " << index << ": xi = " << params.xi
+                              << " не действует для layer, используется " << LayerProblem::xi << '\n';
+                    params.xi = LayerProblem::xi;
+                }
+                model.setProblem<LayerProblem>();
+            } else {
+                model.setProblem<SinProblem>();
+            }
+            model.setParams(params);
+
+            if (job.mode == Job::Mode::Transient) {
+                runTransient(model, job, index, options, out);
+                continue;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            SolverModel::Result result;
+            switch (job.mode) {
+            case Job::Mode::Accuracy: result = model.solveWithAccuracy(params.epsilon); break;
+            case Job::Mode::Adaptive: result = model.solveAdaptive(params.epsilon); break;
+            case Job::Mode::Solve: result = model.solve(); break;
+            case Job::Mode::Transient: break; // Выполнено в runTransient
+            }
+            const bool multiLevel = job.mode != Job::Mode::Solve;
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            out << index << ',' << params.mu1 << ',' << params.mu2 << ',' << params.xi << ','
+                << params.n << ',' << params.epsilon << ',' << methodName(params.method) << ','
+                << params.richardson << ',' << modeName(job.mode) << ',' << job.problem << ','
+                << result.x.size() - 1 << ',' << std::max<size_t>(1, result.convergenceData.size()) << ','
+                << result.maxError << ',' << seconds;
+            const PhaseTimings timings = multiLevel ? sumTimings(result.timingData) : result.timings;
+            for (double phaseSeconds : timings.seconds) {
+                out << ',' << phaseSeconds;
+            }
+            out << '\n';
+
+            if (timingsFile.is_open()) {
+                const std::vector<PhaseTimings> timingLevels = multiLevel ? result.timingData
+                                                                   : std::vector<PhaseTimings>{result.timings};
+                timingsFile << "{\"job\": " << index << ", \"timings\": " << timingsToJson(timingLevels) << "}\n";
+            }
+
+            if (!options.solutionPrefix.empty() && options.format == "result") {
+                writeResultFile(options.solutionPrefix + "_" + std::to_string(index) + ".res",
+                                params, result, model.problem().name());
+            } else if (!options.solutionPrefix.empty()) {
+                std::string extension = options.format == "binary" ? ".bin" : ".csv";
+                writeSolution(options.solutionPrefix + "_" + std::to_string(index) + extension,
+                              options.format, result);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Задание " << index << ": " << e.what() << '\n';
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+# Численное ядро решателя без Qt: собирается в библиотеку thomasSolver.pro
+# (её подключают GUI и CLI через SolverLibrary.pri) и напрямую в бенчмарк
+CONFIG += c++17
+
+# Без сжатия a*b+c в FMA: пакетная прогонка должна совпадать со скалярной побитово
+gcc: QMAKE_CXXFLAGS += -ffp-contract=off
+
+# Векторизация циклов по узлам (VectorMath.hpp, ErrorNorms.cpp): при -O2 GCC 12
+# по умолчанию пропускает циклы, которым нужен скалярный хвост или проверка пересечения массивов
+*-g++*: QMAKE_CXXFLAGS += -fvect-cost-model=dynamic
+
+# Сборка без замеров времени по фазам решения (SolverProfiler.hpp)
+# DEFINES += SOLVER_NO_PROFILING
+
+# Сборка без журнала ядра (SolverLog.hpp)
+# DEFINES += SOLVER_NO_LOGGING
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/AdaptiveMesh.cpp \
+    $$PWD/AdiSolver.cpp \
+    $$PWD/BatchThomasSolver.cpp \
+    $$PWD/BlockThomasSolver.cpp \
+    $$PWD/CyclicThomasSolver.cpp \
+    $$PWD/ErrorNorms.cpp \
+    $$PWD/MixedPrecisionSolver.cpp \
+    $$PWD/ParallelThomasSolver.cpp \
+    $$PWD/ResultCache.cpp \
+    $$PWD/ResultFile.cpp \
+    $$PWD/ResultViews.cpp \
+    $$PWD/SolverCApi.cpp \
+    $$PWD/SolverLog.cpp \
+    $$PWD/SolverModel.cpp \
+    $$PWD/SolverProfiler.cpp \
+    $$PWD/StreamingSolver.cpp \
+    $$PWD/SweepEngine.cpp \
+    $$PWD/TimeStepper.cpp
+
+HEADERS += \
+    $$PWD/AdaptiveMesh.hpp \
+    $$PWD/AdiSolver.hpp \
+    $$PWD/BatchThomasSolver.hpp \
+    $$PWD/BlockThomasSolver.hpp \
+    $$PWD/CoefficientPolicy.hpp \
+    $$PWD/CyclicThomasSolver.hpp \
+    $$PWD/ErrorNorms.hpp \
+    $$PWD/MixedPrecisionSolver.hpp \
+    $$PWD/ParallelThomasSolver.hpp \
+    $$PWD/ResultCache.hpp \
+    $$PWD/ResultFile.hpp \
+    $$PWD/ResultViews.hpp \
+    $$PWD/SolverCApi.h \
+    $$PWD/SolverLog.hpp \
+    $$PWD/SolverModel.hpp \
+    $$PWD/SolverProfiler.hpp \
+    $$PWD/StreamingSolver.hpp \
+    $$PWD/SweepEngine.hpp \
+    $$PWD/TimeStepper.hpp \
+    $$PWD/VectorMath.hpp
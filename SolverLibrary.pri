@@ -0,0 +1,16 @@
+# Подключение библиотеки ядра thomasSolver.pro, собранной в том же каталоге сборки
+# (см. thomasAlgorithmAll.pro). DEFINES ядра (SOLVER_NO_PROFILING и др.) меняют
+# его заголовки и должны совпадать с заданными в SolverCore.pri
+CONFIG += c++17 thread
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): SOLVER_LIB_DIR = $$OUT_PWD/release
+else:win32:CONFIG(debug, debug|release): SOLVER_LIB_DIR = $$OUT_PWD/debug
+else: SOLVER_LIB_DIR = $$OUT_PWD
+
+LIBS += -L$$SOLVER_LIB_DIR -lthomasSolver
+
+win32-msvc*: PRE_TARGETDEPS += $$SOLVER_LIB_DIR/thomasSolver.lib
+else: PRE_TARGETDEPS += $$SOLVER_LIB_DIR/libthomasSolver.a
@@ -0,0 +1,52 @@
+#include "SolverLog.hpp"
+#include <cstdio>
+#include <mutex>
+
+namespace solver_log_detail {
+std::atomic<int> threshold{static_cast<int>(SolverLogLevel::Warning)};
+}
+
+namespace {
+
+std::mutex sinkMutex;
+SolverLogSink currentSink = nullptr;
+void* currentContext = nullptr;
+
+const char* levelName(SolverLogLevel level) {
+    switch (level) {
+    case SolverLogLevel::Debug: return "debug";
+    case SolverLogLevel::Info: return "info";
+    case SolverLogLevel::Warning: return "warning";
+    case SolverLogLevel::Error: return "error";
+    case SolverLogLevel::Off: break;
+    }
+    return "";
+}
+
+} // namespace
+
+void setSolverLogSink(SolverLogSink sink, void* context) {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    currentSink = sink;
+    currentContext = context;
+}
+
+void setSolverLogLevel(SolverLogLevel level) {
+    solver_log_detail::threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+SolverLogLevel solverLogLevel() {
+    return static_cast<SolverLogLevel>(solver_log_detail::threshold.load(std::memory_order_relaxed));
+}
+
+void writeSolverLog(SolverLogLevel level, const std::string& message) {
+    if (!solverLogEnabled(level) || level == SolverLogLevel::Off) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    if (currentSink) {
+        currentSink(level, message.c_str(), currentContext);
+    } else {
+        std::fprintf(stderr, "[%s] %s\n", levelName(level), message.c_str());
+    }
+}
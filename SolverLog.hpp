@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+// Журнал численного ядра без зависимости от Qt. Сообщения уходят в приёмник,
+// заданный приложением (GUI пересылает их в qDebug, консольные цели — в stderr).
+// Уровень проверяется до сборки строки: отключённое сообщение стоит одного
+// сравнения, а при сборке с DEFINES += SOLVER_NO_LOGGING не компилируется вовсе.
+enum class SolverLogLevel {
+    Debug,   // Ход сгущения по уровням
+    Info,    // Итог решения
+    Warning,
+    Error,
+    Off
+};
+
+// Приёмник: уровень, сообщение в UTF-8 и контекст, переданный при установке.
+// Вызывается под внутренней блокировкой, сообщения разных потоков не перемешиваются
+using SolverLogSink = void (*)(SolverLogLevel level, const char* message, void* context);
+
+// nullptr — вывод в stderr (по умолчанию)
+void setSolverLogSink(SolverLogSink sink, void* context = nullptr);
+// Сообщения ниже порога отбрасываются; по умолчанию Warning
+void setSolverLogLevel(SolverLogLevel level);
+SolverLogLevel solverLogLevel();
+
+namespace solver_log_detail {
+extern std::atomic<int> threshold;
+}
+
+inline bool solverLogEnabled(SolverLogLevel level) {
+    return static_cast<int>(level) >= solver_log_detail::threshold.load(std::memory_order_relaxed);
+}
+
+void writeSolverLog(SolverLogLevel level, const std::string& message);
+
+// SOLVER_LOG(Debug, "Итерация " << iteration << ": n = " << n);
+#ifndef SOLVER_NO_LOGGING
+
+#define SOLVER_LOG(level, message)                                      \
+    do {                                                                \
+        if (solverLogEnabled(SolverLogLevel::level)) {                  \
+            std::ostringstream solverLogStream;                         \
+            solverLogStream << message;                                 \
+            writeSolverLog(SolverLogLevel::level, solverLogStream.str()); \
+        }                                                               \
+    } while (false)
+
+#else
+
+#define SOLVER_LOG(level, message) ((void)0)
+
+#endif
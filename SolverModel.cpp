@@ -1,145 +1,585 @@
 #include "SolverModel.hpp"
-#include <QDebug>
+#include "AdaptiveMesh.hpp"
+#include "ParallelThomasSolver.hpp"
+#include "ResultCache.hpp"
+#include "SolverLog.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <limits>
+#include <utility>
 
-SolverModel::SolverModel() {
+SolverModel::SolverModel()
+    : m_problem(std::make_shared<PolicyKernels<SinProblem>>()) {
     // Установка параметров по умолчанию
     m_params = {0.0, 0.0, 0.5, 10, 1e-6};
 }
 
+void SolverModel::setProblemKernels(std::shared_ptr<const ProblemKernels> problem) {
+    if (!problem) {
+        throw std::invalid_argument("Задача не задана");
+    }
+    m_problem = std::move(problem);
+
+    // Разложение и кэш коэффициентов относились к прежней задаче
+    m_factorization = Factorization();
+    m_workspace.coefficientsN = 0;
+}
+
 void SolverModel::setParams(const Params& params) {
     if (params.n < 2) {
         throw std::invalid_argument("Количество разбиений должно быть не менее 2");
     }
+    if (params.threads < 0) {
+        throw std::invalid_argument("Число потоков не может быть отрицательным");
+    }
+    if (params.refinements < 0) {
+        throw std::invalid_argument("Число шагов уточнения не может быть отрицательным");
+    }
+    // Разложение зависит только от n и проверяется в isFactorized()
     m_params = params;
 }
 
 SolverModel::Result SolverModel::solve() {
-    // Генерация узлов сетки
-    double h = 1.0 / m_params.n;
-    std::vector<double> x(m_params.n + 1);
-    for (int i = 0; i <= m_params.n; ++i) {
-        x[i] = i * h;
+    if (m_cache) {
+        std::shared_ptr<const Result> result = solveShared();
+        return takeResult(result);
     }
+    Result result;
+    solve(result);
+    return result;
+}
 
-    // Создание массивов коэффициентов для метода прогонки
-    std::vector<double> a(m_params.n + 1, 0.0);
-    std::vector<double> b(m_params.n + 1, 0.0);
-    std::vector<double> c(m_params.n + 1, 0.0);
-    std::vector<double> d(m_params.n + 1, 0.0);
+void SolverModel::solve(Result& result) {
+    if (m_cache) {
+        result = *solveShared();
+        return;
+    }
+    solveLevel(result, nullptr);
+}
 
-    for (int i = 1; i < m_params.n; ++i) {
-        double xi = x[i];
-        auto coeffs = computeCoefficients(xi);
-        double k = coeffs[0];
-        double q = coeffs[1];
-        double f = coeffs[2];
+std::shared_ptr<const SolverModel::Result> SolverModel::solveShared() {
+    std::shared_ptr<Result> spare;
+    return solveLevelCached(nullptr, spare);
+}
 
-        a[i] = k / (h * h);                       // Нижняя диагональ
-        b[i] = -2.0 * k / (h * h) - q;           // Центральная диагональ
-        c[i] = k / (h * h);                       // Верхняя диагональ
-        d[i] = -f;                                // Правая часть
-    }
+void SolverModel::setCache(std::shared_ptr<ResultCache> cache) {
+    m_cache = std::move(cache);
+}
 
-    // Учет граничных условий
-    b[0] = b[m_params.n] = 1.0;
-    d[0] = m_params.mu1;
-    d[m_params.n] = m_params.mu2;
+void SolverModel::solveLevel(Result& result, const Result* coarse) {
+    m_timings = PhaseTimings();
 
-    // Решение методом прогонки
-    std::vector<double> u = thomasAlgorithm(a, b, c, d);
+    // Узлы сетки задаются числом разбиений и вычисляются по запросу
+    const int n = m_params.n;
+    {
+        SOLVER_PROFILE_PHASE(m_timings, SolverPhase::GridGeneration);
+        result.x = GridView::uniform(n);
+    }
 
-    // Вычисление аналитического решения
-    std::vector<double> analytical(m_params.n + 1);
-    for (int i = 0; i <= m_params.n; ++i) {
-        analytical[i] = analyticalSolution(x[i]);
+    if (m_params.method == Method::Fused) {
+        // Сборка совмещена с прямым ходом: в память пишутся только p и q
+        SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ForwardSweep);
+        m_workspace.p.resize(n + 1);
+        result.u.resize(n + 1);
+        m_problem->solveFused(n, m_params.mu1, m_params.mu2, m_workspace.p.data(), result.u.data());
+    } else {
+        // Правая часть с учётом граничных условий
+        std::vector<double>& d = m_workspace.d;
+        rightHandSide(d);
+
+        // Решение методом прогонки
+        if (m_params.method == Method::Parallel) {
+            buildMatrix(m_workspace.a, m_workspace.b, m_workspace.c);
+            SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ForwardSweep);
+            m_workspace.parallelSolver.setThreads(m_params.threads);
+            m_workspace.parallelSolver.solve(m_workspace.a, m_workspace.b, m_workspace.c, d, result.u);
+        } else if (m_params.method == Method::MixedPrecision) {
+            buildMatrix(m_workspace.a, m_workspace.b, m_workspace.c);
+            SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ForwardSweep);
+            MixedPrecisionSolver& solver = m_workspace.mixedSolver;
+            if (solver.maxRefinements() != m_params.refinements) {
+                solver.setMaxRefinements(m_params.refinements);
+            }
+            solver.solve(m_workspace.a, m_workspace.b, m_workspace.c, d, result.u);
+        } else {
+            if (!isFactorized()) {
+                factorize();
+            }
+            solveFactorized(d, result.u);
+        }
     }
 
-    // Вычисление максимальной ошибки
-    double maxError = calculateError(u, analytical);
+    result.analytical = AnalyticalView(m_problem, result.x);
+    {
+        // Аналитическое решение вычисляется вместе с нормами ошибки,
+        // его время входит в ErrorNorms
+        SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ErrorNorms);
+        result.norms = computeErrorNorms(result.x, result.u, result.analytical, coarse ? &coarse->u : nullptr);
+        if (!result.analytical.empty()) {
+            result.maxError = result.norms.maxError;
+        } else if (!coarse) {
+            result.maxError = std::numeric_limits<double>::infinity();
+        } else {
+            // Без аналитического решения точность оценивается по сгущению сетки
+            result.maxError = std::isnan(result.norms.gridError) ? calculateGridError(*coarse, result)
+                                                                 : result.norms.gridError;
+        }
+    }
 
-    Result result;
-    result.x = x;
-    result.u = u;
-    result.analytical = analytical;
-    result.maxError = maxError;
+    result.timings = m_timings;
+}
+
+SolverModel::Result SolverModel::solveWithAccuracy(double targetError, const ProgressCallback& progress) {
+    std::shared_ptr<const Result> result = solveWithAccuracyShared(targetError, progress);
+    return takeResult(result);
+}
+
+std::shared_ptr<const SolverModel::Result> SolverModel::solveWithAccuracyShared(double targetError,
+                                                                               const ProgressCallback& progress) {
+    std::string key;
+    if (m_cache) {
+        key = cacheKey(m_params.n) + accuracyKeySuffix(targetError);
+        if (std::shared_ptr<const Result> hit = m_cache->find(key)) {
+            SOLVER_LOG(Info, "Результат взят из кэша: n = " << hit->x.size() - 1);
+            return hit;
+        }
+    }
 
+    std::shared_ptr<Result> result = refineWithAccuracy(targetError, progress);
+    // Прерванное сгущение не кэшируется: при повторе оно должно продолжиться
+    if (m_cache && !result->cancelled) {
+        m_cache->insert(key, result);
+    }
     return result;
 }
 
-SolverModel::Result SolverModel::solveWithAccuracy(double targetError) {
+std::shared_ptr<SolverModel::Result> SolverModel::refineWithAccuracy(double targetError,
+                                                                     const ProgressCallback& progress) {
     Params originalParams = m_params; // Сохраняем исходные параметры
-    Result finalResult;              // Итоговый результат
-    Result refinedResult;            // Для уточнённых данных
+    auto finalResult = std::make_shared<Result>(); // Итоговый результат
+    std::shared_ptr<const Result> result;        // Решение на текущей сетке
+    std::shared_ptr<const Result> refinedResult; // Решение на предыдущей (вдвое более грубой) сетке
+    // С экстраполяцией Ричардсона — ещё вдвое более грубый уровень: экстраполированное
+    // решение лежит на сетке refinedResult, и предыдущий для него уровень — этот
+    std::shared_ptr<const Result> coarserResult;
+    std::shared_ptr<const Result> finalLevel;    // Уровень, который становится итоговым результатом
+    std::shared_ptr<Result> spare;               // Буферы уровня, не попавшего в кэш
     std::vector<ConvergenceData> convergenceData; // Временное хранилище данных о сходимости
+    std::vector<PhaseTimings> timingData;         // Время по фазам на каждом уровне
+    bool cancelled = false;
 
     double previousError = std::numeric_limits<double>::max();
     double relativeImprovement = 0.0;
 
     const int maxIterations = 1000; // Максимальное количество итераций
     int iteration = 0;
+    const auto start = std::chrono::steady_clock::now();
 
     while (iteration < maxIterations) {
-        Result result = solve(); // Вызываем основное решение
+        // Чётные узлы новой сетки совпадают с узлами предыдущей; уровни из кэша не пересчитываются
+        result = solveLevelCached(refinedResult.get(), spare);
 
         // Сохраняем данные для построения графика сходимости
-        convergenceData.push_back({m_params.n, result.maxError});
-        qDebug() << "Итерация" << iteration
-                 << ": n =" << m_params.n
-                 << ", maxError =" << result.maxError;
+        convergenceData.push_back({m_params.n, result->maxError});
+        timingData.push_back(result->timings);
+        SOLVER_LOG(Debug, "Итерация " << iteration << ": n = " << m_params.n
+                                      << ", maxError = " << result->maxError);
+
+        if (progress) {
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            cancelled = !progress({iteration, m_params.n, result->maxError, elapsed});
+        }
 
         // Проверяем достижение целевой точности
-        if (result.maxError <= targetError) {
-            qDebug() << "Целевая точность достигнута.";
-            finalResult = result; // Сохраняем результат
+        if (result->maxError <= targetError) {
+            SOLVER_LOG(Info, "Целевая точность достигнута.");
+            cancelled = false;
+            finalLevel = std::move(result); // Сохраняем результат
+            break;
+        }
+
+        if (cancelled) {
+            SOLVER_LOG(Info, "Сгущение прервано.");
+            finalLevel = std::move(result);
             break;
         }
 
+        // Экстраполяция Ричардсона: (4 u_h/2 - u_h) / 3 в узлах грубой сетки имеет порядок O(h^4)
+        if (m_params.richardson && iteration > 0) {
+            Result extrapolated;
+            extrapolate(*refinedResult, *result, coarserResult.get(), extrapolated);
+            SOLVER_LOG(Debug, "Экстраполяция Ричардсона: maxError = " << extrapolated.maxError);
+
+            if (extrapolated.maxError <= targetError) {
+                SOLVER_LOG(Info, "Целевая точность достигнута экстраполяцией.");
+                *finalResult = std::move(extrapolated);
+                refinedResult = std::move(coarserResult); // Вдвое более грубый уровень, если был
+                break;
+            }
+        }
+
         // Вычисляем относительное улучшение ошибки
-        relativeImprovement = std::abs(previousError - result.maxError) / previousError;
+        relativeImprovement = std::abs(previousError - result->maxError) / previousError;
 
         // Завершаем цикл, если ошибка перестала уменьшаться
         if (relativeImprovement < 1e-6) {
-            qDebug() << "Сходимость достигнута: относительное улучшение =" << relativeImprovement;
-            finalResult = result; // Сохраняем результат
+            SOLVER_LOG(Info, "Сходимость достигнута: относительное улучшение = " << relativeImprovement);
+            finalLevel = std::move(result); // Сохраняем результат
             break;
         }
 
-        previousError = result.maxError;
+        previousError = result->maxError;
 
-        // Удвоение количества разбиений сетки
+        // Удвоение количества разбиений сетки; буферы вытесняемого уровня
+        // переиспользуются, если на него не ссылается кэш
         m_params.n *= 2;
-        refinedResult = result; // Сохраняем текущий результат как уточнённый
+        std::shared_ptr<const Result>& evicted = m_params.richardson ? coarserResult : refinedResult;
+        if (evicted && evicted.use_count() == 1) {
+            spare = std::const_pointer_cast<Result>(evicted);
+        }
+        if (m_params.richardson) {
+            coarserResult = std::move(refinedResult);
+        }
+        refinedResult = std::move(result); // Сохраняем текущий результат как уточнённый
         iteration++;
     }
 
     if (iteration >= maxIterations) {
-        qDebug() << "Достигнуто максимальное количество итераций.";
-        finalResult = refinedResult; // Сохраняем последний уточнённый результат
+        SOLVER_LOG(Info, "Достигнуто максимальное количество итераций.");
+        finalLevel = refinedResult; // Сохраняем последний уточнённый результат
+    }
+
+    spare.reset();
+    coarserResult.reset();
+    if (finalLevel) {
+        *finalResult = takeResult(finalLevel);
     }
 
     // Добавляем данные о сходимости к итоговому результату
-    finalResult.convergenceData = std::move(convergenceData);
-    finalResult.uRefined = refinedResult.u; // Передаём уточнённое решение
-    finalResult.maxErrorRefined = refinedResult.maxError;
+    finalResult->convergenceData = std::move(convergenceData);
+    finalResult->timingData = std::move(timingData);
+    finalResult->cancelled = cancelled;
+    if (refinedResult) {
+        // Уточнённое решение разделяется с уровнем, а не копируется
+        finalResult->xRefined = refinedResult->x;
+        finalResult->uRefined = std::shared_ptr<const std::vector<double>>(refinedResult, &refinedResult->u);
+        finalResult->analyticalRefined = refinedResult->analytical;
+        finalResult->maxErrorRefined = refinedResult->maxError;
+    }
 
     m_params = originalParams; // Возврат к исходным параметрам
     return finalResult;
 }
 
+std::shared_ptr<const SolverModel::Result> SolverModel::solveLevelCached(const Result* coarse,
+                                                                         std::shared_ptr<Result>& spare) {
+    std::string key;
+    if (m_cache) {
+        // Уровень с предыдущей сеткой хранит norms.gridError (а без аналитического
+        // решения и maxError), зависящие от неё
+        key = cacheKey(m_params.n);
+        if (coarse) {
+            key += "|coarse";
+        }
+        if (std::shared_ptr<const Result> hit = m_cache->find(key)) {
+            return hit;
+        }
+    }
 
+    std::shared_ptr<Result> level = spare ? std::move(spare) : std::make_shared<Result>();
+    solveLevel(*level, coarse);
+    if (m_cache) {
+        m_cache->insert(key, level);
+    }
+    return level;
+}
+
+SolverModel::Result SolverModel::takeResult(std::shared_ptr<const Result>& result) {
+    // Единственная ссылка — результат не разделяется с кэшем и переносится без копирования
+    if (result.use_count() == 1) {
+        Result owned = std::move(*std::const_pointer_cast<Result>(result));
+        result.reset();
+        return owned;
+    }
+    return *result;
+}
 
-std::vector<double> SolverModel::computeCoefficients(double x) {
-    // Для данного примера используем постоянные коэффициенты
-    return {1.0, 0.0, M_PI * M_PI * std::sin(M_PI * x)}; // k, q, f
+std::string SolverModel::cacheKey(int n) const {
+    // Шестнадцатеричная запись double: разные значения не сливаются при округлении
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), "%s|%a|%a|%a|%d|%d|%d|%d", m_problem->name(),
+                  m_params.mu1, m_params.mu2, m_params.xi, n, static_cast<int>(m_params.method),
+                  m_params.method == Method::Parallel ? m_params.threads : 0,
+                  m_params.method == Method::MixedPrecision ? m_params.refinements : 0);
+    return buffer;
+}
+
+std::string SolverModel::accuracyKeySuffix(double targetError) const {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "|accuracy|%a|%d", targetError, m_params.richardson ? 1 : 0);
+    return buffer;
+}
+
+SolverModel::Result SolverModel::solveAdaptive(double targetError, const ProgressCallback& progress) {
+    const int maxIterations = 200;
+    const size_t maxNodes = size_t(1) << 26;
+    const double markFraction = 0.5; // Делятся интервалы с оценкой выше markFraction * targetError
+
+    Result result;
+    std::vector<double> x = makeInitialMesh(m_params.n, m_params.xi);
+    std::vector<double>& a = m_workspace.a;
+    std::vector<double>& b = m_workspace.b;
+    std::vector<double>& c = m_workspace.c;
+    std::vector<double>& d = m_workspace.d;
+    std::vector<double> p;
+    std::vector<double> errors;
+    std::vector<char> marked;
+    const bool hasAnalytical = m_problem->hasAnalyticalSolution();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        m_timings = PhaseTimings();
+        const int n = static_cast<int>(x.size()) - 1;
+
+        {
+            SOLVER_PROFILE_PHASE(m_timings, SolverPhase::Assembly);
+            a.assign(n + 1, 0.0);
+            b.assign(n + 1, 0.0);
+            c.assign(n + 1, 0.0);
+            d.resize(n + 1);
+            m_problem->assembleNonUniform(n, x.data(), a.data(), b.data(), c.data(), d.data());
+
+            // Учет граничных условий
+            b[0] = b[n] = 1.0;
+            d[0] = m_params.mu1;
+            d[n] = m_params.mu2;
+        }
+        {
+            SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ForwardSweep);
+            thomasAlgorithm(a, b, c, d, p, result.u);
+        }
+        result.x = GridView::nodes(x);
+        result.analytical = AnalyticalView(m_problem, result.x);
+
+        // Оценка ошибки по интервалам; без аналитического решения она же служит итоговой ошибкой
+        double estimate;
+        {
+            SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ErrorNorms);
+            estimateIntervalErrors(x, result.u, errors);
+            estimate = *std::max_element(errors.begin(), errors.end());
+            result.norms = computeErrorNorms(result.x, result.u, result.analytical);
+            result.maxError = hasAnalytical ? result.norms.maxError : estimate;
+        }
+        result.timings = m_timings;
+        result.convergenceData.push_back({n, result.maxError});
+        result.timingData.push_back(m_timings);
+        SOLVER_LOG(Debug, "Адаптивная итерация " << iteration << ": n = " << n
+                                                << ", maxError = " << result.maxError
+                                                << ", оценка = " << estimate);
+
+        bool cancelled = false;
+        if (progress) {
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            cancelled = !progress({iteration, n, result.maxError, elapsed});
+        }
+        if (result.maxError <= targetError) {
+            SOLVER_LOG(Info, "Целевая точность достигнута.");
+            break;
+        }
+        if (cancelled) {
+            SOLVER_LOG(Info, "Сгущение прервано.");
+            result.cancelled = true;
+            break;
+        }
+        if (x.size() >= maxNodes) {
+            SOLVER_LOG(Info, "Достигнуто максимальное количество узлов.");
+            break;
+        }
+
+        // Если оценка уже ниже порога, а ошибка нет, делятся интервалы с наибольшей оценкой
+        const double threshold = std::min(markFraction * targetError, markFraction * estimate);
+        marked.assign(errors.size(), 0);
+        for (size_t i = 0; i < errors.size(); ++i) {
+            marked[i] = errors[i] > threshold;
+        }
+        refineMesh(x, marked);
+    }
+
+    return result;
+}
+
+StreamingSolver::Summary SolverModel::solveToFile(const StreamingSolver::Options& options, long long n) {
+    // n = 0 — число разбиений из параметров; больше INT_MAX задаётся явно
+    StreamingSolver streamingSolver(m_problem);
+    return streamingSolver.solve(m_params.mu1, m_params.mu2, n > 0 ? n : m_params.n, options);
+}
+
+TimeStepper::Summary SolverModel::solveTransient(std::vector<double>& u, const TimeStepper::Options& options) {
+    TimeStepper stepper(m_problem);
+    return stepper.run(m_params.n, m_params.mu1, m_params.mu2, u, options);
+}
+
+void SolverModel::extrapolate(const Result& coarse, const Result& fine, const Result* coarser,
+                              Result& extrapolated) {
+    const size_t size = coarse.u.size();
+    extrapolated.x = coarse.x;
+    extrapolated.analytical = coarse.analytical;
+    extrapolated.u.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        extrapolated.u[i] = (4.0 * fine.u[2 * i] - coarse.u[i]) / 3.0;
+    }
+    // Время последнего решения — мелкого уровня — вместе с нормами экстраполяции
+    extrapolated.timings = fine.timings;
+    {
+        SOLVER_PROFILE_PHASE(extrapolated.timings, SolverPhase::ErrorNorms);
+        extrapolated.norms = computeErrorNorms(extrapolated.x, extrapolated.u, extrapolated.analytical,
+                                               coarser ? &coarser->u : nullptr);
+    }
+    extrapolated.maxError = extrapolated.norms.maxError;
+}
+
+void SolverModel::updateNodeCoefficients() {
+    const int n = m_params.n;
+    Workspace& ws = m_workspace;
+    if (ws.coefficientsN == n) {
+        return;
+    }
+
+    const double h = 1.0 / n;
+    const bool nested = ws.coefficientsN > 0 && 2 * ws.coefficientsN == n;
+    ws.f.resize(n + 1);
+
+    if (nested) {
+        // Перенос значений грубой сетки в чётные узлы (с конца, чтобы не затереть исходные)
+        for (int i = n / 2; i > 0; --i) {
+            ws.f[2 * i] = ws.f[i];
+        }
+        m_problem->evaluateRightHandSide(h, 1, n - 1, 2, ws.f.data());
+    } else {
+        m_problem->evaluateRightHandSide(h, 0, n, 1, ws.f.data());
+    }
+    ws.coefficientsN = n;
+}
+
+void SolverModel::buildMatrix(std::vector<double>& a, std::vector<double>& b, std::vector<double>& c) {
+    SOLVER_PROFILE_PHASE(m_timings, SolverPhase::Assembly);
+    const int n = m_params.n;
+    a.assign(n + 1, 0.0);
+    b.assign(n + 1, 0.0);
+    c.assign(n + 1, 0.0);
+
+    m_problem->assembleMatrix(n, a.data(), b.data(), c.data());
+
+    // Учет граничных условий
+    b[0] = b[n] = 1.0;
+}
+
+std::vector<double> SolverModel::rightHandSide() {
+    std::vector<double> d;
+    rightHandSide(d);
+    return d;
+}
+
+void SolverModel::rightHandSide(std::vector<double>& d) {
+    SOLVER_PROFILE_PHASE(m_timings, SolverPhase::Assembly);
+    updateNodeCoefficients();
+
+    const int n = m_params.n;
+    d.resize(n + 1);
+
+    for (int i = 1; i < n; ++i) {
+        d[i] = -m_workspace.f[i];
+    }
+    d[0] = m_params.mu1;
+    d[n] = m_params.mu2;
+}
+
+void SolverModel::factorize() {
+    std::vector<double>& b = m_workspace.b;
+    std::vector<double>& c = m_workspace.c;
+    buildMatrix(m_factorization.a, b, c);
+
+    SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ForwardSweep);
+    const std::vector<double>& a = m_factorization.a;
+    int n = b.size();
+    std::vector<double>& p = m_factorization.p;
+    std::vector<double>& invDenom = m_factorization.invDenom;
+    p.assign(n, 0.0);
+    invDenom.assign(n, 0.0);
+
+    // Прямой ход по матрице; p вычисляется делением, как в thomasAlgorithm,
+    // чтобы погрешность округления не накапливалась в рекурсии
+    invDenom[0] = 1.0 / b[0];
+    p[0] = -c[0] / b[0];
+    for (int i = 1; i < n; ++i) {
+        double denom = b[i] + a[i] * p[i - 1];
+        if (fabs(denom) < 1e-12) { // Проверка на деление на ноль
+            m_factorization = Factorization();
+            throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+        }
+        invDenom[i] = 1.0 / denom;
+        p[i] = -c[i] / denom;
+    }
+}
+
+bool SolverModel::isFactorized() const {
+    return static_cast<int>(m_factorization.p.size()) == m_params.n + 1;
+}
+
+std::vector<double> SolverModel::solveFactorized(const std::vector<double>& rhs) const {
+    std::vector<double> u;
+    solveFactorized(rhs, u);
+    return u;
+}
+
+void SolverModel::solveFactorized(const std::vector<double>& rhs, std::vector<double>& u) const {
+    if (!isFactorized() || rhs.size() != m_factorization.p.size()) {
+        throw std::logic_error("Разложение не соответствует размеру правой части");
+    }
+
+    const std::vector<double>& a = m_factorization.a;
+    const std::vector<double>& p = m_factorization.p;
+    const std::vector<double>& invDenom = m_factorization.invDenom;
+    int n = rhs.size();
+    u.resize(n);
+
+    // Прямой ход по правой части: u хранит q
+    {
+        SOLVER_PROFILE_PHASE(m_timings, SolverPhase::ForwardSweep);
+        u[0] = rhs[0] * invDenom[0];
+        for (int i = 1; i < n; ++i) {
+            u[i] = (rhs[i] - a[i] * u[i - 1]) * invDenom[i];
+        }
+    }
+
+    // Обратный ход
+    SOLVER_PROFILE_PHASE(m_timings, SolverPhase::BackSubstitution);
+    for (int i = n - 2; i >= 0; --i) {
+        u[i] = p[i] * u[i + 1] + u[i];
+    }
 }
 
 std::vector<double> SolverModel::thomasAlgorithm(const std::vector<double>& a,
                                                  const std::vector<double>& b,
                                                  const std::vector<double>& c,
                                                  const std::vector<double>& d) {
+    std::vector<double> p, u;
+    thomasAlgorithm(a, b, c, d, p, u);
+    return u;
+}
+
+void SolverModel::thomasAlgorithm(const std::vector<double>& a,
+                                  const std::vector<double>& b,
+                                  const std::vector<double>& c,
+                                  const std::vector<double>& d,
+                                  std::vector<double>& p,
+                                  std::vector<double>& u) {
     int n = b.size();
-    std::vector<double> p(n, 0.0), q(n, 0.0), u(n, 0.0);
+    p.resize(n);
+    u.resize(n);
+    std::vector<double>& q = u; // q хранится в u и перезаписывается обратным ходом
 
     // Прямой ход
     p[0] = -c[0] / b[0];
@@ -154,16 +594,13 @@ std::vector<double> SolverModel::thomasAlgorithm(const std::vector<double>& a,
     }
 
     // Обратный ход
-    u[n - 1] = q[n - 1];
     for (int i = n - 2; i >= 0; --i) {
         u[i] = p[i] * u[i + 1] + q[i];
     }
-
-    return u;
 }
 
 double SolverModel::analyticalSolution(double x) {
-    return std::sin(M_PI * x); // Корректное аналитическое решение для данного примера
+    return m_problem->analytical(x);
 }
 
 double SolverModel::calculateError(const std::vector<double>& numerical,
@@ -175,6 +612,20 @@ double SolverModel::calculateError(const std::vector<double>& numerical,
     return maxError;
 }
 
+double SolverModel::calculateError(const std::vector<double>& numerical, const AnalyticalView& analytical) {
+    const size_t block = 512;
+    double values[block];
+    double maxError = 0.0;
+    for (size_t first = 0; first < numerical.size(); first += block) {
+        const size_t count = std::min(block, numerical.size() - first);
+        analytical.evaluate(first, count, values);
+        for (size_t j = 0; j < count; ++j) {
+            maxError = std::max(maxError, std::abs(numerical[first + j] - values[j]));
+        }
+    }
+    return maxError;
+}
+
 double SolverModel::calculateGridError(const Result& coarse, const Result& fine) {
     double maxError = 0.0;
     for (size_t i = 0; i < coarse.x.size(); ++i) {
@@ -1,15 +1,42 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
+#include "CoefficientPolicy.hpp"
+#include "ErrorNorms.hpp"
+#include "MixedPrecisionSolver.hpp"
+#include "ParallelThomasSolver.hpp"
+#include "ResultViews.hpp"
+#include "SolverProfiler.hpp"
+#include "StreamingSolver.hpp"
+#include "TimeStepper.hpp"
+
+class ResultCache;
 
 class SolverModel {
 public:
+    // Метод решения трёхдиагональной системы
+    enum class Method {
+        Thomas,   // Последовательная прогонка
+        Parallel, // Параллельная прогонка методом разбиения (ParallelThomasSolver)
+        MixedPrecision, // Прогонка в float с уточнением в double (MixedPrecisionSolver)
+        Fused // Сборка и прогонка за один проход (ProblemKernels::solveFused); разложение не кэшируется
+    };
+
     struct Params {
         double mu1;
         double mu2;
         double xi;
         int n;
         double epsilon;
+        Method method = Method::Thomas;
+        int threads = 0; // Число потоков для Method::Parallel, 0 — по числу ядер
+        bool richardson = false; // Экстраполяция Ричардсона по двум последним сеткам в solveWithAccuracy
+        // Наибольшее число шагов уточнения для Method::MixedPrecision. При 0 возвращается
+        // решение прогонки в float без уточнения: его точность ниже, чем у thomasAlgorithm
+        int refinements = 3;
     };
 
     struct ConvergenceData {
@@ -17,38 +44,153 @@ public:
         double error;
     };
 
+    // Собственный массив только u: узлы и аналитическое решение вычисляются
+    // по запросу (ResultViews.hpp), решение соседнего уровня разделяется
     struct Result {
-        std::vector<double> x;
+        GridView x;
         std::vector<double> u;
-        std::vector<double> analytical;
+        AnalyticalView analytical;
         double maxError;
+        // maxError, L2-норма, относительная ошибка, узел максимума и отличие
+        // от предыдущего уровня, вычисленные за один проход (computeErrorNorms)
+        ErrorNorms norms;
 
         // Для основной задачи
-        std::vector<double> xRefined;
-        std::vector<double> uRefined;
-        std::vector<double> analyticalRefined;
+        GridView xRefined;
+        SharedArray uRefined;
+        AnalyticalView analyticalRefined;
         double maxErrorRefined;
 
         // Данные для графика сходимости
         std::vector<ConvergenceData> convergenceData;
+
+        // Время по фазам: последнего решения и каждого уровня сгущения (параллельно convergenceData)
+        PhaseTimings timings;
+        std::vector<PhaseTimings> timingData;
+
+        // Сгущение прервано до достижения точности; результат — последний решённый уровень
+        bool cancelled = false;
+    };
+
+    // Завершённый уровень сгущения в solveWithAccuracy
+    struct Progress {
+        int iteration;
+        int n;
+        double maxError;
+        double elapsed; // Секунды с начала решения
+    };
+
+    // Вызывается после каждого уровня; false прерывает сгущение
+    using ProgressCallback = std::function<bool(const Progress&)>;
+
+    // Разложение матрицы прогонки, не зависящее от правой части
+    struct Factorization {
+        std::vector<double> a;        // Нижняя диагональ (нужна для рекурсии q)
+        std::vector<double> p;        // Прогоночные коэффициенты p
+        std::vector<double> invDenom; // Обратные знаменатели 1 / (b_i + a_i * p_{i-1})
+    };
+
+    // Рабочие массивы, которые переиспользуются между вызовами solve
+    struct Workspace {
+        std::vector<double> a;
+        std::vector<double> b;
+        std::vector<double> c;
+        std::vector<double> d;
+        ParallelThomasSolver parallelSolver;
+        MixedPrecisionSolver mixedSolver;
+        std::vector<double> p; // Прогоночные коэффициенты для Method::Fused
+
+        // Правая часть f в узлах сетки с coefficientsN разбиениями; при удвоении n
+        // значения в чётных узлах переносятся без пересчёта. k и q не кэшируются:
+        // они встраиваются в сборку матрицы, которая выполняется раз на разложение
+        std::vector<double> f;
+        int coefficientsN = 0;
     };
 
     SolverModel();
     void setParams(const Params& params);
+
+    // Подключение задачи через политику коэффициентов (см. CoefficientPolicy.hpp)
+    template <typename Problem>
+    void setProblem() {
+        setProblemKernels(std::make_shared<PolicyKernels<Problem>>());
+    }
+    void setProblemKernels(std::shared_ptr<const ProblemKernels> problem);
+    const ProblemKernels& problem() const { return *m_problem; }
+
+    // Кэш результатов (см. ResultCache), общий для копий модели; nullptr — без кэша.
+    // Уровни сгущения кэшируются по отдельности, поэтому повтор с меньшим epsilon
+    // проходит уже решённые сетки без пересчёта
+    void setCache(std::shared_ptr<ResultCache> cache);
+    const std::shared_ptr<ResultCache>& cache() const { return m_cache; }
+
     Result solve();
-    Result solveWithAccuracy(double targetError);
+    // Решение в переданный результат: при повторных вызовах с тем же n
+    // буферы result и рабочие массивы модели не перевыделяются
+    void solve(Result& result);
+    Result solveWithAccuracy(double targetError, const ProgressCallback& progress = {});
+    // Варианты без копирования: результат может разделяться с кэшем
+    std::shared_ptr<const Result> solveShared();
+    std::shared_ptr<const Result> solveWithAccuracyShared(double targetError,
+                                                          const ProgressCallback& progress = {});
+    // Адаптивное сгущение неравномерной сетки: начальная сетка из n разбиений с узлом в xi,
+    // делятся только интервалы с большой оценкой ошибки. Узлы result.x неравномерны,
+    // convergenceData хранит число разбиений и ошибку на каждом шаге
+    Result solveAdaptive(double targetError, const ProgressCallback& progress = {});
+    // Потоковое решение с текущими параметрами: решение пишется в файл,
+    // память ограничена окном options.chunkNodes (см. StreamingSolver)
+    StreamingSolver::Summary solveToFile(const StreamingSolver::Options& options, long long n = 0);
+    // Интегрирование u_t = k u'' - q u + f с текущими n, mu1, mu2 (см. TimeStepper):
+    // u — начальное условие (пустое — линейное между mu1 и mu2), на выходе — решение
+    // в конечный момент; снимки пишутся в options.snapshotPath
+    TimeStepper::Summary solveTransient(std::vector<double>& u, const TimeStepper::Options& options);
+
+    // Прямой ход по матрице выполняется один раз для текущего n;
+    // затем каждая правая часть решается без делений
+    void factorize();
+    bool isFactorized() const;
+    std::vector<double> rightHandSide();
+    void rightHandSide(std::vector<double>& d);
+    std::vector<double> solveFactorized(const std::vector<double>& rhs) const;
+    void solveFactorized(const std::vector<double>& rhs, std::vector<double>& u) const;
+
+    static std::vector<double> thomasAlgorithm(const std::vector<double>& a,
+                                               const std::vector<double>& b,
+                                               const std::vector<double>& c,
+                                               const std::vector<double>& d);
+    // Вариант без выделения памяти: p и u — буферы вызывающей стороны
+    static void thomasAlgorithm(const std::vector<double>& a,
+                                const std::vector<double>& b,
+                                const std::vector<double>& c,
+                                const std::vector<double>& d,
+                                std::vector<double>& p,
+                                std::vector<double>& u);
 
     double analyticalSolution(double x);
     double calculateError(const std::vector<double>& numerical, const std::vector<double>& analytical);
+    // Аналитическое решение вычисляется блоками, без массива на всю сетку
+    double calculateError(const std::vector<double>& numerical, const AnalyticalView& analytical);
     double calculateGridError(const Result& coarse, const Result& fine);
 
 private:
     Params m_params;
+    Factorization m_factorization; // Действительно, пока размер p равен n + 1
+    Workspace m_workspace;
+    std::shared_ptr<const ProblemKernels> m_problem;
+    mutable PhaseTimings m_timings; // Накапливается с начала текущего solveLevel
+    std::shared_ptr<ResultCache> m_cache;
 
-    std::vector<double> computeCoefficients(double x);
-    std::vector<double> thomasAlgorithm(const std::vector<double>& a,
-                                        const std::vector<double>& b,
-                                        const std::vector<double>& c,
-                                        const std::vector<double>& d);
+    void updateNodeCoefficients();
+    void solveLevel(Result& result, const Result* coarse);
+    // Уровень из кэша либо решение в spare (или новый результат) с записью в кэш
+    std::shared_ptr<const Result> solveLevelCached(const Result* coarse, std::shared_ptr<Result>& spare);
+    std::shared_ptr<Result> refineWithAccuracy(double targetError, const ProgressCallback& progress);
+    // Перенос результата, если ссылка единственная, иначе копия
+    static Result takeResult(std::shared_ptr<const Result>& result);
+    std::string cacheKey(int n) const;
+    std::string accuracyKeySuffix(double targetError) const;
+    // Решение на сетке coarse; coarser — вдвое более грубый уровень для gridError или nullptr
+    void extrapolate(const Result& coarse, const Result& fine, const Result* coarser, Result& extrapolated);
+    void buildMatrix(std::vector<double>& a, std::vector<double>& b, std::vector<double>& c);
 };
 
@@ -0,0 +1,64 @@
+#include "SolverProfiler.hpp"
+#include <iomanip>
+#include <sstream>
+
+double PhaseTimings::total() const {
+    double sum = 0.0;
+    for (double value : seconds) {
+        sum += value;
+    }
+    return sum;
+}
+
+const char* PhaseTimings::phaseName(SolverPhase phase) {
+    switch (phase) {
+    case SolverPhase::GridGeneration: return "GridGeneration";
+    case SolverPhase::Assembly: return "Assembly";
+    case SolverPhase::ForwardSweep: return "ForwardSweep";
+    case SolverPhase::BackSubstitution: return "BackSubstitution";
+    case SolverPhase::ErrorNorms: return "ErrorNorms";
+    case SolverPhase::Display: return "Display";
+    case SolverPhase::Count: break;
+    }
+    return "Unknown";
+}
+
+std::string timingsToJson(const std::vector<PhaseTimings>& levels) {
+    std::ostringstream out;
+    out.precision(9);
+    out << "{\"levels\": [";
+    for (size_t level = 0; level < levels.size(); ++level) {
+        out << (level > 0 ? ", " : "") << "{";
+        for (int phase = 0; phase < PhaseTimings::phaseCount; ++phase) {
+            out << (phase > 0 ? ", " : "") << "\"" << PhaseTimings::phaseName(static_cast<SolverPhase>(phase))
+                << "\": " << levels[level].seconds[phase];
+        }
+        out << "}";
+    }
+    out << "]}";
+    return out.str();
+}
+
+PhaseTimings sumTimings(const std::vector<PhaseTimings>& levels) {
+    PhaseTimings sum;
+    for (const PhaseTimings& level : levels) {
+        for (int phase = 0; phase < PhaseTimings::phaseCount; ++phase) {
+            sum.seconds[phase] += level.seconds[phase];
+            sum.calls[phase] += level.calls[phase];
+        }
+    }
+    return sum;
+}
+
+std::string timingsSummary(const PhaseTimings& timings) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    for (int phase = 0; phase < PhaseTimings::phaseCount; ++phase) {
+        if (timings.calls[phase] > 0) {
+            out << "  " << PhaseTimings::phaseName(static_cast<SolverPhase>(phase)) << ": "
+                << timings.seconds[phase] * 1e3 << " мс\n";
+        }
+    }
+    out << "  Всего: " << timings.total() * 1e3 << " мс\n";
+    return out.str();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Фазы решения, по которым собирается время
+enum class SolverPhase {
+    GridGeneration,   // Узлы сетки
+    Assembly,         // Коэффициенты и правая часть
+    ForwardSweep,     // Прямой ход (для параллельной прогонки — всё решение)
+    BackSubstitution, // Обратный ход
+    ErrorNorms,       // Аналитическое решение и нормы ошибки (один проход, ErrorNorms.hpp)
+    Display,          // Заполнение таблиц и графиков
+    Count
+};
+
+// Время и число входов по фазам для одного уровня сетки
+struct PhaseTimings {
+    static const int phaseCount = static_cast<int>(SolverPhase::Count);
+
+    double seconds[phaseCount] = {};
+    long long calls[phaseCount] = {};
+
+    void add(SolverPhase phase, double elapsed) {
+        seconds[static_cast<int>(phase)] += elapsed;
+        ++calls[static_cast<int>(phase)];
+    }
+    double operator[](SolverPhase phase) const { return seconds[static_cast<int>(phase)]; }
+    double total() const;
+
+    static const char* phaseName(SolverPhase phase);
+};
+
+// {"levels": [{"GridGeneration": 1.2e-05, ...}, ...]} — время в секундах
+std::string timingsToJson(const std::vector<PhaseTimings>& levels);
+
+// Сумма по уровням сгущения
+PhaseTimings sumTimings(const std::vector<PhaseTimings>& levels);
+
+// Строки "Фаза: время мс" для ненулевых фаз — для информационной панели
+std::string timingsSummary(const PhaseTimings& timings);
+
+// Измерение отключается целиком при сборке с DEFINES += SOLVER_NO_PROFILING
+#ifndef SOLVER_NO_PROFILING
+
+class ScopedPhaseTimer {
+public:
+    ScopedPhaseTimer(PhaseTimings& timings, SolverPhase phase)
+        : m_timings(timings), m_phase(phase), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedPhaseTimer() {
+        m_timings.add(m_phase, std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    PhaseTimings& m_timings;
+    SolverPhase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define SOLVER_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SOLVER_PROFILE_CONCAT(a, b) SOLVER_PROFILE_CONCAT_IMPL(a, b)
+#define SOLVER_PROFILE_PHASE(timings, phase) \
+    ScopedPhaseTimer SOLVER_PROFILE_CONCAT(phaseTimer, __LINE__)((timings), (phase))
+
+#else
+
+#define SOLVER_PROFILE_PHASE(timings, phase) ((void)0)
+
+#endif
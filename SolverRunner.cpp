@@ -0,0 +1,84 @@
+#include "SolverRunner.hpp"
+#include <QtConcurrent/QtConcurrentRun>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+SolverRunner::SolverRunner(QObject* parent)
+    : QObject(parent) {
+    connect(&m_watcher, &QFutureWatcher<Outcome>::finished, this, &SolverRunner::onFutureFinished);
+}
+
+SolverRunner::~SolverRunner() {
+    // Рабочий поток испускает сигналы этого объекта — дожидаемся его завершения
+    cancel();
+    m_watcher.waitForFinished();
+}
+
+void SolverRunner::startSolve(const SolverModel& model) {
+    start(model, Mode::Single, 0.0);
+}
+
+void SolverRunner::startSolveWithAccuracy(const SolverModel& model, double targetError) {
+    start(model, Mode::Accuracy, targetError);
+}
+
+void SolverRunner::startSolveAdaptive(const SolverModel& model, double targetError) {
+    start(model, Mode::Adaptive, targetError);
+}
+
+void SolverRunner::cancel() {
+    if (m_cancelRequested) {
+        m_cancelRequested->store(true);
+    }
+}
+
+void SolverRunner::start(SolverModel model, Mode mode, double targetError) {
+    if (isRunning()) {
+        throw std::runtime_error("Решение уже выполняется");
+    }
+
+    // Свой флаг на каждый запуск: отмена не переходит на следующий расчёт
+    auto cancelRequested = std::make_shared<std::atomic<bool>>(false);
+    m_cancelRequested = cancelRequested;
+
+    m_watcher.setFuture(QtConcurrent::run([this, model = std::move(model), mode, targetError,
+                                           cancelRequested]() mutable {
+        Outcome outcome;
+        try {
+            auto reportProgress = [this, &cancelRequested](const SolverModel::Progress& level) {
+                emit progress(level.iteration, level.n, level.maxError, level.elapsed);
+                return !cancelRequested->load();
+            };
+            if (mode == Mode::Accuracy) {
+                outcome.result = model.solveWithAccuracyShared(targetError, reportProgress);
+            } else if (mode == Mode::Adaptive) {
+                outcome.result = std::make_shared<SolverModel::Result>(
+                    model.solveAdaptive(targetError, reportProgress));
+            } else {
+                auto start = std::chrono::steady_clock::now();
+                auto result = model.solveShared();
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                emit progress(0, static_cast<int>(result->x.size()) - 1, result->maxError, elapsed);
+                if (!cancelRequested->load()) {
+                    outcome.result = std::move(result);
+                }
+            }
+        } catch (const std::exception& e) {
+            outcome.error = QString::fromUtf8(e.what());
+        }
+        return outcome;
+    }));
+}
+
+void SolverRunner::onFutureFinished() {
+    Outcome outcome = m_watcher.result();
+    if (!outcome.error.isEmpty()) {
+        emit failed(outcome.error);
+    } else if (outcome.result) {
+        emit finished(std::move(outcome.result));
+    } else {
+        emit cancelled();
+    }
+}
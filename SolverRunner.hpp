@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include "SolverModel.hpp"
+
+// Фоновое решение в пуле потоков (QThreadPool::globalInstance).
+// Каждый запуск работает с копией модели, поэтому модель виджета остаётся
+// доступной в потоке интерфейса; ход сгущения приходит сигналом progress.
+class SolverRunner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SolverRunner(QObject* parent = nullptr);
+    ~SolverRunner() override;
+
+    bool isRunning() const { return m_watcher.isRunning(); }
+
+    // Одиночное решение на сетке из параметров модели
+    void startSolve(const SolverModel& model);
+    // Сгущение до точности targetError
+    void startSolveWithAccuracy(const SolverModel& model, double targetError);
+    // Адаптивное сгущение неравномерной сетки до точности targetError
+    void startSolveAdaptive(const SolverModel& model, double targetError);
+
+    // Сгущение останавливается после текущего уровня и возвращает последний решённый уровень
+    void cancel();
+
+signals:
+    // Испускается из рабочего потока, доставляется в поток получателя
+    void progress(int iteration, int n, double maxError, double elapsed);
+    // Результат разделяется между таблицами и графиками без копирования
+    void finished(std::shared_ptr<const SolverModel::Result> result);
+    void failed(const QString& message);
+    // Одиночное решение отменено — результата нет
+    void cancelled();
+
+private slots:
+    void onFutureFinished();
+
+private:
+    struct Outcome {
+        std::shared_ptr<const SolverModel::Result> result;
+        QString error;
+    };
+
+    enum class Mode { Single, Accuracy, Adaptive };
+
+    void start(SolverModel model, Mode mode, double targetError);
+
+    QFutureWatcher<Outcome> m_watcher;
+    std::shared_ptr<std::atomic<bool>> m_cancelRequested;
+};
@@ -0,0 +1,213 @@
+#include "StreamingSolver.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STREAMING_SOLVER_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef STREAMING_SOLVER_POSIX
+
+[[noreturn]] void throwSystemError(const std::string& what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Файловый дескриптор, закрываемый при выходе из области видимости
+class FileHandle {
+public:
+    FileHandle(const std::string& path, int flags)
+        : m_fd(::open(path.c_str(), flags, 0644)) {
+        if (m_fd < 0) {
+            throwSystemError("Не удалось открыть файл " + path);
+        }
+    }
+    ~FileHandle() { ::close(m_fd); }
+
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+
+    int fd() const { return m_fd; }
+
+    void resize(long long bytes) {
+        if (::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0) {
+            throwSystemError("Не удалось задать размер файла");
+        }
+    }
+
+    void writeAt(const double* data, long long count, long long offset) {
+        const char* bytes = reinterpret_cast<const char*>(data);
+        size_t left = static_cast<size_t>(count) * sizeof(double);
+        off_t position = static_cast<off_t>(offset);
+        while (left > 0) {
+            ssize_t written = ::pwrite(m_fd, bytes, left, position);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throwSystemError("Ошибка записи решения");
+            }
+            bytes += written;
+            left -= static_cast<size_t>(written);
+            position += written;
+        }
+    }
+
+private:
+    int m_fd;
+};
+
+// Окно отображения части файла в память
+class MappedWindow {
+public:
+    MappedWindow(int fd, long long offset, size_t length, int protection)
+        : m_length(length) {
+        m_data = ::mmap(nullptr, length, protection, MAP_SHARED, fd, static_cast<off_t>(offset));
+        if (m_data == MAP_FAILED) {
+            throwSystemError("Не удалось отобразить временный файл");
+        }
+    }
+    ~MappedWindow() { ::munmap(m_data, m_length); }
+
+    MappedWindow(const MappedWindow&) = delete;
+    MappedWindow& operator=(const MappedWindow&) = delete;
+
+    double* data() const { return static_cast<double*>(m_data); }
+
+private:
+    void* m_data;
+    size_t m_length;
+};
+
+// Временный файл удаляется и при исключении
+struct ScratchFileGuard {
+    std::string path;
+    ~ScratchFileGuard() { ::unlink(path.c_str()); }
+};
+
+#endif // STREAMING_SOLVER_POSIX
+
+} // namespace
+
+StreamingSolver::StreamingSolver(std::shared_ptr<const ProblemKernels> problem)
+    : m_problem(std::move(problem)) {
+    if (!m_problem) {
+        throw std::invalid_argument("Задача не задана");
+    }
+}
+
+StreamingSolver::Summary StreamingSolver::solve(double mu1, double mu2, long long n,
+                                                const Options& options) {
+    if (n < 2) {
+        throw std::invalid_argument("Количество разбиений должно быть не менее 2");
+    }
+
+#ifndef STREAMING_SOLVER_POSIX
+    (void)mu1;
+    (void)mu2;
+    (void)options;
+    throw std::runtime_error("Потоковый режим поддерживается только в POSIX-системах");
+#else
+    // Окно кратно странице: в файле на узел приходится пара (p, q)
+    const long long nodeBytes = 2 * sizeof(double);
+    const long long pageNodes = std::max(1L, ::sysconf(_SC_PAGESIZE)) / nodeBytes;
+    long long chunk = std::min<long long>(std::max(options.chunkNodes, pageNodes), 1 << 28);
+    chunk = (chunk + pageNodes - 1) / pageNodes * pageNodes;
+
+    const long long total = n + 1;
+    m_a.resize(chunk);
+    m_b.resize(chunk);
+    m_c.resize(chunk);
+    m_d.resize(chunk);
+
+    FileHandle scratch(options.scratchPath, O_RDWR | O_CREAT | O_TRUNC);
+    ScratchFileGuard scratchGuard{options.scratchPath};
+    scratch.resize(total * nodeBytes);
+
+    // Прямой ход: коэффициенты окна собираются на лету, p и q уходят в файл
+    double pPrev = 0.0;
+    double qPrev = 0.0;
+    for (long long first = 0; first < total; first += chunk) {
+        const int count = static_cast<int>(std::min(chunk, total - first));
+        double* a = m_a.data();
+        double* b = m_b.data();
+        double* c = m_c.data();
+        double* d = m_d.data();
+        m_problem->assembleRows(n, first, count, a, b, c, d);
+
+        // Учет граничных условий
+        if (first == 0) {
+            a[0] = c[0] = 0.0;
+            b[0] = 1.0;
+            d[0] = mu1;
+        }
+        if (first + count == total) {
+            a[count - 1] = c[count - 1] = 0.0;
+            b[count - 1] = 1.0;
+            d[count - 1] = mu2;
+        }
+
+        MappedWindow window(scratch.fd(), first * nodeBytes, count * nodeBytes,
+                            PROT_READ | PROT_WRITE);
+        double* pq = window.data();
+        for (int j = 0; j < count; ++j) {
+            double p;
+            double q;
+            if (first + j == 0) {
+                p = -c[j] / b[j];
+                q = d[j] / b[j];
+            } else {
+                double denom = b[j] + a[j] * pPrev;
+                if (std::fabs(denom) < 1e-12) { // Проверка на деление на ноль
+                    throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+                }
+                p = -c[j] / denom;
+                q = (d[j] - a[j] * qPrev) / denom;
+            }
+            pq[2 * j] = p;
+            pq[2 * j + 1] = q;
+            pPrev = p;
+            qPrev = q;
+        }
+    }
+
+    // Обратный ход: окна читаются с конца, решение пишется в выходной файл
+    const bool hasAnalytical = m_problem->hasAnalyticalSolution();
+    if (hasAnalytical) {
+        m_analytical.resize(chunk);
+    }
+    FileHandle output(options.outputPath, O_WRONLY | O_CREAT | O_TRUNC);
+    output.resize(total * static_cast<long long>(sizeof(double)));
+
+    double uNext = 0.0;
+    double maxError = 0.0;
+    for (long long first = (total - 1) / chunk * chunk; first >= 0; first -= chunk) {
+        const int count = static_cast<int>(std::min(chunk, total - first));
+        MappedWindow window(scratch.fd(), first * nodeBytes, count * nodeBytes, PROT_READ);
+        const double* pq = window.data();
+        double* u = m_d.data();
+
+        for (int j = count - 1; j >= 0; --j) {
+            u[j] = first + j == total - 1 ? pq[2 * j + 1] : pq[2 * j] * uNext + pq[2 * j + 1];
+            uNext = u[j];
+        }
+
+        if (hasAnalytical) {
+            m_problem->evaluateAnalyticalRows(n, first, count, m_analytical.data());
+            for (int j = 0; j < count; ++j) {
+                maxError = std::max(maxError, std::abs(u[j] - m_analytical[j]));
+            }
+        }
+
+        output.writeAt(u, count, first * static_cast<long long>(sizeof(double)));
+    }
+
+    return {n, hasAnalytical ? maxError : std::numeric_limits<double>::quiet_NaN()};
+#endif
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "CoefficientPolicy.hpp"
+
+// Потоковая прогонка для сеток, не помещающихся в память.
+// Коэффициенты собираются по окнам из chunkNodes узлов, прогоночные коэффициенты
+// p и q прямого хода пишутся в отображаемый в память временный файл, обратный ход
+// читает его окнами с конца и дописывает решение u в выходной файл.
+// Резидентная память ограничена размером окна, а не числом узлов.
+class StreamingSolver {
+public:
+    struct Options {
+        std::string scratchPath;        // Временный файл для p и q (удаляется после решения)
+        std::string outputPath;         // Решение: n + 1 значений double подряд
+        long long chunkNodes = 1 << 20; // Узлов в одном окне
+    };
+
+    struct Summary {
+        long long n;
+        double maxError; // NaN, если у задачи нет аналитического решения
+    };
+
+    explicit StreamingSolver(std::shared_ptr<const ProblemKernels> problem);
+
+    Summary solve(double mu1, double mu2, long long n, const Options& options);
+
+private:
+    std::shared_ptr<const ProblemKernels> m_problem;
+
+    // Буферы одного окна
+    std::vector<double> m_a;
+    std::vector<double> m_b;
+    std::vector<double> m_c;
+    std::vector<double> m_d;
+    std::vector<double> m_analytical;
+};
@@ -0,0 +1,185 @@
+#include "SweepEngine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+size_t axisSize(const std::vector<double>& values) {
+    return values.empty() ? 1 : values.size();
+}
+
+// Очередь номеров конфигураций потока: владелец берёт с конца,
+// остальные забирают половину с начала
+class WorkQueue {
+public:
+    void push(size_t index) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_items.push_back(index);
+    }
+
+    bool pop(size_t& index) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_items.empty()) {
+            return false;
+        }
+        index = m_items.back();
+        m_items.pop_back();
+        return true;
+    }
+
+    // Перенос половины очереди (не меньше одного элемента) в thief
+    bool stealInto(WorkQueue& thief) {
+        std::deque<size_t> stolen;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const size_t count = (m_items.size() + 1) / 2;
+            if (count == 0) {
+                return false;
+            }
+            stolen.assign(m_items.begin(), m_items.begin() + count);
+            m_items.erase(m_items.begin(), m_items.begin() + count);
+        }
+        std::lock_guard<std::mutex> lock(thief.m_mutex);
+        thief.m_items.insert(thief.m_items.end(), stolen.begin(), stolen.end());
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::deque<size_t> m_items;
+};
+
+} // namespace
+
+size_t ParameterSpace::size() const {
+    return axisSize(mu1) * axisSize(mu2) * axisSize(xi) * axisSize(epsilon);
+}
+
+SolverModel::Params ParameterSpace::at(size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("Номер конфигурации вне пространства параметров");
+    }
+    SolverModel::Params params = base;
+    auto take = [&index](const std::vector<double>& values, double& target) {
+        if (!values.empty()) {
+            target = values[index % values.size()];
+        }
+        index /= axisSize(values);
+    };
+    take(epsilon, params.epsilon);
+    take(xi, params.xi);
+    take(mu2, params.mu2);
+    take(mu1, params.mu1);
+    return params;
+}
+
+SweepEngine::SweepEngine(int threads)
+    : m_threads(threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))) {}
+
+SweepEngine::Stats SweepEngine::run(const SolverModel& prototype, const ParameterSpace& space,
+                                    const SweepSink& sink) {
+    std::vector<SolverModel::Params> configurations;
+    configurations.reserve(space.size());
+    for (size_t i = 0; i < space.size(); ++i) {
+        configurations.push_back(space.at(i));
+    }
+    return run(prototype, configurations, sink);
+}
+
+SweepEngine::Stats SweepEngine::run(const SolverModel& prototype,
+                                    const std::vector<SolverModel::Params>& configurations,
+                                    const SweepSink& sink) {
+    m_cancelled.store(false);
+    const int workers = static_cast<int>(std::min<size_t>(m_threads, std::max<size_t>(1, configurations.size())));
+
+    // Начальное распределение — смежными блоками: соседние конфигурации близки
+    // по стоимости, и перекос между блоками выравнивается захватом работы
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    for (int w = 0; w < workers; ++w) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = configurations.size(); i-- > 0;) {
+        queues[i * workers / configurations.size()]->push(i);
+    }
+
+    Stats stats;
+    stats.tasks.assign(workers, 0);
+    std::atomic<size_t> steals{0};
+    std::mutex sinkMutex;
+    std::exception_ptr sinkError;
+
+    auto worker = [&](int id) {
+        SolverModel model = prototype;
+        WorkQueue& own = *queues[id];
+        size_t index;
+
+        while (!m_cancelled.load()) {
+            if (!own.pop(index)) {
+                // Обход остальных очередей, начиная со следующей. Работа раздаётся
+                // один раз до запуска, поэтому если украсть нечего, она уже не появится
+                bool stolen = false;
+                for (int k = 1; k < workers && !stolen; ++k) {
+                    stolen = queues[(id + k) % workers]->stealInto(own);
+                }
+                if (!stolen) {
+                    break;
+                }
+                ++steals;
+                continue;
+            }
+
+            SweepResult result;
+            result.index = index;
+            result.params = configurations[index];
+            result.worker = id;
+            auto start = std::chrono::steady_clock::now();
+            try {
+                model.setParams(result.params);
+                SolverModel::Result solution = model.solveWithAccuracy(result.params.epsilon);
+                result.finalN = static_cast<int>(solution.x.size()) - 1;
+                result.maxError = solution.maxError;
+                result.convergenceData = std::move(solution.convergenceData);
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            } catch (...) {
+                result.error = "Неизвестная ошибка";
+            }
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++stats.tasks[id];
+
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                if (!sinkError) {
+                    try {
+                        sink(result);
+                    } catch (...) {
+                        sinkError = std::current_exception();
+                        m_cancelled.store(true);
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (int w = 1; w < workers; ++w) {
+        threads.emplace_back(worker, w);
+    }
+    worker(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (sinkError) {
+        std::rethrow_exception(sinkError);
+    }
+    stats.steals = steals.load();
+    return stats;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "SolverModel.hpp"
+
+// Декартово произведение значений mu1, mu2, xi и epsilon поверх базовых параметров.
+// Пустой список оставляет значение из base
+struct ParameterSpace {
+    SolverModel::Params base{0.0, 0.0, 0.5, 10, 1e-6};
+    std::vector<double> mu1;
+    std::vector<double> mu2;
+    std::vector<double> xi;
+    std::vector<double> epsilon;
+
+    size_t size() const;
+    // Конфигурация с номером index; epsilon меняется быстрее остальных
+    SolverModel::Params at(size_t index) const;
+};
+
+// Итог одной конфигурации
+struct SweepResult {
+    size_t index;
+    SolverModel::Params params;
+    int finalN = 0;
+    double maxError = 0.0;
+    std::vector<SolverModel::ConvergenceData> convergenceData;
+    double seconds = 0.0;
+    int worker = 0;
+    std::string error; // Текст исключения; пусто — решение успешно
+};
+
+// Вызывается по мере готовности конфигураций, в порядке завершения;
+// вызовы сериализованы, синхронизация в приёмнике не нужна
+using SweepSink = std::function<void(const SweepResult&)>;
+
+// Параллельный перебор конфигураций solveWithAccuracy. У каждого потока своя
+// копия модели и своя очередь номеров; опустевший поток забирает половину
+// очереди другого потока (work stealing), поэтому дорогие конфигурации
+// с малым epsilon не оставляют остальные потоки без работы.
+class SweepEngine {
+public:
+    struct Stats {
+        std::vector<size_t> tasks; // Решено каждым потоком
+        size_t steals = 0;         // Успешных захватов чужой работы
+    };
+
+    // threads = 0 — по числу аппаратных потоков
+    explicit SweepEngine(int threads = 0);
+
+    int threads() const { return m_threads; }
+
+    // prototype задаёт задачу и метод; параметры берутся из space.
+    // Исключение приёмника прерывает перебор и пробрасывается вызывающему
+    Stats run(const SolverModel& prototype, const ParameterSpace& space, const SweepSink& sink);
+    Stats run(const SolverModel& prototype, const std::vector<SolverModel::Params>& configurations,
+              const SweepSink& sink);
+
+    // Новые конфигурации не запускаются; уже идущие решения доводятся до конца
+    void cancel() { m_cancelled.store(true); }
+
+private:
+    int m_threads;
+    std::atomic<bool> m_cancelled{false};
+};
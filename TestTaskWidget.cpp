@@ -1,4 +1,5 @@
 #include "TestTaskWidget.hpp"
+#include "ChartDecimation.hpp"
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -7,14 +8,13 @@
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QLogValueAxis>
 #include <QTabWidget>
-#include <QDebug>
 #include <limits>
 #include <cmath>
 
 using namespace QtCharts;
 
 TestTaskWidget::TestTaskWidget(QWidget* parent)
-    : QWidget(parent), m_model(nullptr) {
+    : QWidget(parent), m_model(nullptr), m_runner(new SolverRunner(this)) {
     setupUI();
 }
 
@@ -36,6 +36,8 @@ void TestTaskWidget::setupUI() {
     m_spinBoxEpsilon->setValue(0.5e-6);
 
     m_solveButton = new QPushButton("Решить", this);
+    m_cancelButton = new QPushButton("Отмена", this);
+    m_cancelButton->setEnabled(false);
 
     QHBoxLayout* inputLayout = new QHBoxLayout();
     inputLayout->addWidget(labelN);
@@ -43,6 +45,7 @@ void TestTaskWidget::setupUI() {
     inputLayout->addWidget(labelEpsilon);
     inputLayout->addWidget(m_spinBoxEpsilon);
     inputLayout->addWidget(m_solveButton);
+    inputLayout->addWidget(m_cancelButton);
 
     m_infoText = new QTextEdit(this);
     m_infoText->setMaximumHeight(100);
@@ -54,10 +57,8 @@ void TestTaskWidget::setupUI() {
     // Вкладка "Таблица"
     QWidget* tableTab = new QWidget(this);
     QVBoxLayout* tableLayout = new QVBoxLayout(tableTab);
-    m_resultsTable = new QTableWidget(this);
-    m_resultsTable->setColumnCount(4);
-    m_resultsTable->setHorizontalHeaderLabels({"x_i", "u(x_i)", "v(x_i)", "u(x_i) - v(x_i)"});
-    m_resultsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_resultsTableModel = new ResultTableModel(ResultTableModel::Layout::Solution, this);
+    m_resultsTable = createResultTableView(m_resultsTableModel, this);
     tableLayout->addWidget(m_resultsTable);
     tableTab->setLayout(tableLayout);
 
@@ -68,6 +69,7 @@ void TestTaskWidget::setupUI() {
     m_plot->setRenderHint(QPainter::Antialiasing);
     m_errorPlot = new QChartView(new QChart(), this);
     m_errorPlot->setRenderHint(QPainter::Antialiasing);
+    setupCharts();
     plotLayout->addWidget(new QLabel("График решений:"));
     plotLayout->addWidget(m_plot);
     plotLayout->addWidget(new QLabel("График погрешности:"));
@@ -86,6 +88,20 @@ void TestTaskWidget::setupUI() {
     setLayout(mainLayout);
 
     connect(m_solveButton, &QPushButton::clicked, this, &TestTaskWidget::onSolveButtonClicked);
+    connect(m_cancelButton, &QPushButton::clicked, m_runner, &SolverRunner::cancel);
+    connect(m_runner, &SolverRunner::finished, this, &TestTaskWidget::onSolveFinished);
+    connect(m_runner, &SolverRunner::failed, this, &TestTaskWidget::onSolveFailed);
+    connect(m_runner, &SolverRunner::cancelled, this, [this]() {
+        setRunning(false);
+        m_infoText->setText("Решение отменено.");
+    });
+}
+
+void TestTaskWidget::setRunning(bool running) {
+    m_solveButton->setEnabled(!running);
+    m_cancelButton->setEnabled(running);
+    m_spinBoxN->setEnabled(!running);
+    m_spinBoxEpsilon->setEnabled(!running);
 }
 
 void TestTaskWidget::onSolveButtonClicked() {
@@ -103,70 +119,88 @@ void TestTaskWidget::onSolveButtonClicked() {
 
     try {
         m_model->setParams(params);
-        SolverModel::Result result = m_model->solve();
-        displayResults(result);
     } catch (const std::exception& e) {
         QMessageBox::critical(this, "Ошибка", e.what());
+        return;
     }
+
+    m_infoText->setText(QString("Решение на сетке n = %1...").arg(params.n));
+    setRunning(true);
+    m_runner->startSolve(*m_model);
 }
 
-void TestTaskWidget::displayResults(const SolverModel::Result& result) {
-    double maxDeviation = 0.0;
-    double maxDeviationPoint = 0.0;
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        double deviation = std::abs(result.u[i] - result.analytical[i]);
-        if (deviation > maxDeviation) {
-            maxDeviation = deviation;
-            maxDeviationPoint = result.x[i];
+void TestTaskWidget::onSolveFinished(std::shared_ptr<const SolverModel::Result> result) {
+    setRunning(false);
+
+    try {
+        PhaseTimings displayTimings;
+        {
+            SOLVER_PROFILE_PHASE(displayTimings, SolverPhase::Display);
+            displayResults(result);
         }
+        m_infoText->append(QString("Отображение результатов: %1 мс")
+                               .arg(displayTimings[SolverPhase::Display] * 1e3, 0, 'f', 3));
+    } catch (const std::exception& e) {
+        QMessageBox::critical(this, "Ошибка", e.what());
     }
+}
+
+void TestTaskWidget::onSolveFailed(const QString& message) {
+    setRunning(false);
+    QMessageBox::critical(this, "Ошибка", message);
+}
+
+void TestTaskWidget::displayResults(const std::shared_ptr<const SolverModel::Result>& resultPtr) {
+    const SolverModel::Result& result = *resultPtr;
+
+    // Узел наибольшего отклонения найден вместе с нормами ошибки
+    const double maxDeviationPoint = result.x[result.norms.maxIndex];
 
     QString info;
     info += QString("Для решения задачи использована равномерная сетка с числом разбиений n = %1.\n").arg(result.x.size() - 1);
     info += "Задача должна быть решена с погрешностью не более ε = 0.5⋅10⁻⁶.\n";
     info += QString("Задача решена с погрешностью ε₁ = %1.\n").arg(result.maxError);
+    info += QString("Норма ошибки в L2: %1, относительная погрешность: %2.\n")
+                .arg(result.norms.l2Error).arg(result.norms.relativeError);
     info += QString("Максимальное отклонение аналитического и численного решений наблюдается в точке x = %1.\n").arg(maxDeviationPoint);
+    info += "Время по фазам:\n";
+    info += QString::fromStdString(timingsSummary(result.timings));
     m_infoText->setText(info);
 
-    m_resultsTable->setRowCount(result.x.size());
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        m_resultsTable->setItem(i, 0, new QTableWidgetItem(QString::number(result.x[i])));
-        m_resultsTable->setItem(i, 1, new QTableWidgetItem(QString::number(result.analytical[i])));
-        m_resultsTable->setItem(i, 2, new QTableWidgetItem(QString::number(result.u[i])));
-        m_resultsTable->setItem(i, 3, new QTableWidgetItem(QString::number(result.u[i] - result.analytical[i])));
-    }
-    m_resultsTable->resizeColumnsToContents();
-
-    QChart* chart = m_plot->chart();
-    chart->removeAllSeries();
+    // Таблица читает результат напрямую, строки форматируются при отрисовке
+    m_resultsTableModel->setResult(resultPtr);
 
-    QLineSeries* numericalSeries = new QLineSeries();
-    QLineSeries* analyticalSeries = new QLineSeries();
+    // Ряды прорежены до ширины области построения и заменяются целиком
+    // Аналитическое решение вычисляется векторизованно небольшими блоками
+    BlockValues<AnalyticalView> analytical(result.analytical);
+    const int pixelWidth = chartPixelWidth(m_plot);
+    m_numericalSeries->replace(decimateMinMax(result.x, [&](size_t i) { return result.u[i]; }, pixelWidth));
+    m_analyticalSeries->replace(decimateMinMax(result.x, [&](size_t i) { return analytical(i); }, pixelWidth));
+    fitAxesToSeries(m_plot->chart());
 
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        numericalSeries->append(result.x[i], result.u[i]);
-        analyticalSeries->append(result.x[i], result.analytical[i]);
-    }
+    m_errorSeries->replace(decimateMinMax(result.x, [&](size_t i) { return std::abs(result.u[i] - analytical(i)); },
+                                          chartPixelWidth(m_errorPlot)));
+    fitAxesToSeries(m_errorPlot->chart());
+}
 
-    chart->addSeries(numericalSeries);
-    chart->addSeries(analyticalSeries);
+void TestTaskWidget::setupCharts() {
+    // Ряды создаются один раз и переиспользуются между решениями
+    QChart* chart = m_plot->chart();
+    m_numericalSeries = new QLineSeries();
+    m_analyticalSeries = new QLineSeries();
+    m_numericalSeries->setName("Численное решение");
+    m_analyticalSeries->setName("Аналитическое решение");
+    chart->addSeries(m_numericalSeries);
+    chart->addSeries(m_analyticalSeries);
     chart->setTitle("Сравнение аналитического и численного решений");
     chart->createDefaultAxes();
-    numericalSeries->setName("Численное решение");
-    analyticalSeries->setName("Аналитическое решение");
     chart->legend()->show();
 
     QChart* errorChart = m_errorPlot->chart();
-    errorChart->removeAllSeries();
-
-    QLineSeries* errorSeries = new QLineSeries();
-    for (size_t i = 0; i < result.x.size(); ++i) {
-        errorSeries->append(result.x[i], std::abs(result.u[i] - result.analytical[i]));
-    }
-
-    errorChart->addSeries(errorSeries);
+    m_errorSeries = new QLineSeries();
+    m_errorSeries->setName("Погрешность");
+    errorChart->addSeries(m_errorSeries);
     errorChart->setTitle("График погрешности");
     errorChart->createDefaultAxes();
-    errorSeries->setName("Погрешность");
     errorChart->legend()->show();
 }
@@ -6,9 +6,13 @@
 #include <QDoubleSpinBox>
 #include <QPushButton>
 #include <QTextEdit>
-#include <QTableWidget>
+#include <QTableView>
+#include <QTabWidget>
 #include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include "ResultTableModel.hpp"
 #include "SolverModel.hpp"
+#include "SolverRunner.hpp"
 
 class TestTaskWidget : public QWidget {
     Q_OBJECT
@@ -19,20 +23,30 @@ public:
 
 private slots:
     void onSolveButtonClicked();
+    void onSolveFinished(std::shared_ptr<const SolverModel::Result> result);
+    void onSolveFailed(const QString& message);
 
 private:
     void setupUI();
-    void displayResults(const SolverModel::Result& result);
+    void setupCharts();
+    void displayResults(const std::shared_ptr<const SolverModel::Result>& result);
+    void setRunning(bool running);
 
     SolverModel* m_model;
+    SolverRunner* m_runner;
 
     QSpinBox* m_spinBoxN;
     QDoubleSpinBox* m_spinBoxEpsilon;
     QTextEdit* m_infoText;
-    QTableWidget* m_resultsTable;
+    QTableView* m_resultsTable;
+    ResultTableModel* m_resultsTableModel;
     QtCharts::QChartView* m_plot;
     QtCharts::QChartView* m_errorPlot;
+    QtCharts::QLineSeries* m_numericalSeries;
+    QtCharts::QLineSeries* m_analyticalSeries;
+    QtCharts::QLineSeries* m_errorSeries;
     QPushButton* m_solveButton;
+    QPushButton* m_cancelButton;
 
     QTabWidget* m_tabWidget;
 };
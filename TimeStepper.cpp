@@ -0,0 +1,174 @@
+#include "TimeStepper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+TimeStepper::TimeStepper(std::shared_ptr<const ProblemKernels> problem)
+    : m_problem(std::move(problem)) {
+    if (!m_problem) {
+        throw std::invalid_argument("Задача не задана");
+    }
+}
+
+void TimeStepper::prepare(int n, double mu1, double mu2, Scheme scheme, double tau) {
+    if (isPrepared() && n == m_n && mu1 == m_mu1 && mu2 == m_mu2 && scheme == m_scheme && tau == m_tau) {
+        return;
+    }
+    if (n < 2) {
+        throw std::invalid_argument("Число разбиений должно быть не меньше 2");
+    }
+    if (!(tau > 0.0)) {
+        throw std::invalid_argument("Шаг по времени должен быть положительным");
+    }
+    m_p.clear(); // Разложение недействительно до конца сборки
+
+    const double theta = scheme == Scheme::BackwardEuler ? 1.0 : 0.5;
+    const double implicitWeight = theta * tau;
+    const double explicitWeight = (1.0 - theta) * tau;
+    const size_t size = n + 1;
+
+    // Диагонали оператора Λu = k u'' - q u и f собираются в массивы явной части
+    // и тут же пересчитываются в её коэффициенты
+    m_alpha.assign(size, 0.0);
+    m_beta.assign(size, 0.0);
+    m_gamma.assign(size, 0.0);
+    m_g.resize(size);
+    m_problem->assembleMatrix(n, m_alpha.data(), m_beta.data(), m_gamma.data());
+    m_problem->evaluateRightHandSide(1.0 / n, 0, n, 1, m_g.data());
+
+    std::vector<double> p(size, 0.0);
+    m_a.assign(size, 0.0);
+    m_invDenom.assign(size, 1.0); // Граничные строки: b = 1, a = c = 0
+    m_q.resize(size);
+    for (int i = 1; i < n; ++i) {
+        const double a = m_alpha[i];
+        const double b = m_beta[i];
+        const double c = m_gamma[i];
+
+        // Строка неявной матрицы I - θτΛ и её прямой ход
+        m_a[i] = -implicitWeight * a;
+        const double denom = 1.0 - implicitWeight * b + m_a[i] * p[i - 1];
+        if (std::fabs(denom) < 1e-12) { // Проверка на деление на ноль
+            throw std::runtime_error("Нулевой знаменатель в методе прогонки");
+        }
+        m_invDenom[i] = 1.0 / denom;
+        p[i] = implicitWeight * c / denom;
+
+        m_alpha[i] = explicitWeight * a;
+        m_beta[i] = 1.0 + explicitWeight * b;
+        m_gamma[i] = explicitWeight * c;
+        m_g[i] *= tau;
+    }
+
+    m_n = n;
+    m_mu1 = mu1;
+    m_mu2 = mu2;
+    m_scheme = scheme;
+    m_tau = tau;
+    m_p.swap(p);
+}
+
+double TimeStepper::step(std::vector<double>& u) {
+    if (!isPrepared() || u.size() != m_p.size()) {
+        throw std::logic_error("Разложение не соответствует размеру решения");
+    }
+    const int n = m_n;
+    const double* a = m_a.data();
+    const double* invDenom = m_invDenom.data();
+    const double* g = m_g.data();
+    double* q = m_q.data();
+    const double* values = u.data();
+
+    // Правая часть вычисляется внутри прямого хода и в память не пишется
+    q[0] = m_mu1;
+    if (m_scheme == Scheme::BackwardEuler) {
+        for (int i = 1; i < n; ++i) {
+            q[i] = (values[i] + g[i] - a[i] * q[i - 1]) * invDenom[i];
+        }
+    } else {
+        const double* alpha = m_alpha.data();
+        const double* beta = m_beta.data();
+        const double* gamma = m_gamma.data();
+        for (int i = 1; i < n; ++i) {
+            const double rhs = alpha[i] * values[i - 1] + beta[i] * values[i] + gamma[i] * values[i + 1] + g[i];
+            q[i] = (rhs - a[i] * q[i - 1]) * invDenom[i];
+        }
+    }
+
+    // Обратный ход с нормой изменения за шаг
+    const double* p = m_p.data();
+    double change = std::max(std::fabs(m_mu1 - u[0]), std::fabs(m_mu2 - u[n]));
+    u[n] = m_mu2;
+    for (int i = n - 1; i > 0; --i) {
+        const double next = p[i] * u[i + 1] + q[i];
+        change = std::max(change, std::fabs(next - u[i]));
+        u[i] = next;
+    }
+    u[0] = m_mu1;
+    return change;
+}
+
+TimeStepper::Summary TimeStepper::run(int n, double mu1, double mu2, std::vector<double>& u,
+                                      const Options& options) {
+    if (options.steps < 0 || options.snapshotEvery < 0) {
+        throw std::invalid_argument("Число шагов и период снимков не могут быть отрицательными");
+    }
+    prepare(n, mu1, mu2, options.scheme, options.tau);
+    if (u.empty()) {
+        u.resize(n + 1);
+        for (int i = 0; i <= n; ++i) {
+            const double x = static_cast<double>(i) / n;
+            u[i] = mu1 + (mu2 - mu1) * x;
+        }
+    } else if (static_cast<int>(u.size()) != n + 1) {
+        throw std::invalid_argument("Размер начального условия не равен n + 1");
+    }
+
+    Summary summary{0, 0.0, 0, 0.0, std::numeric_limits<double>::quiet_NaN()};
+    std::ofstream file;
+    if (!options.snapshotPath.empty()) {
+        file.open(options.snapshotPath, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Не удалось открыть файл снимков " + options.snapshotPath);
+        }
+    }
+    auto writeSnapshot = [&](long long stepIndex) {
+        if (!file.is_open()) {
+            return;
+        }
+        // Время — произведение, а не сумма шагов: без накопления ошибки округления
+        const double time = stepIndex * options.tau;
+        file.write(reinterpret_cast<const char*>(&time), sizeof(double));
+        file.write(reinterpret_cast<const char*>(u.data()), static_cast<std::streamsize>(u.size() * sizeof(double)));
+        if (!file) {
+            throw std::runtime_error("Ошибка записи снимка в " + options.snapshotPath);
+        }
+        ++summary.snapshots;
+    };
+
+    writeSnapshot(0);
+    for (long long stepIndex = 1; stepIndex <= options.steps; ++stepIndex) {
+        summary.lastChange = step(u);
+        if (options.snapshotEvery > 0 && stepIndex % options.snapshotEvery == 0) {
+            writeSnapshot(stepIndex);
+        }
+    }
+    if (options.steps > 0 && (options.snapshotEvery == 0 || options.steps % options.snapshotEvery != 0)) {
+        writeSnapshot(options.steps);
+    }
+
+    summary.steps = options.steps;
+    summary.time = options.steps * options.tau;
+    if (m_problem->hasAnalyticalSolution()) {
+        // Аналитическое решение стационарной задачи вычисляется в буфер прямого хода
+        m_problem->evaluateAnalytical(1.0 / n, 0, n, 1, m_q.data());
+        double error = 0.0;
+        for (int i = 0; i <= n; ++i) {
+            error = std::max(error, std::fabs(u[i] - m_q[i]));
+        }
+        summary.stationaryError = error;
+    }
+    return summary;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "CoefficientPolicy.hpp"
+
+// Неявное интегрирование по времени u_t = k u'' - q u + f с условиями
+// Дирихле u(0) = mu1, u(1) = mu2 (k, q, f — из политики задачи).
+// θ-схема (I - θτΛ) u^{m+1} = (I + (1-θ)τΛ) u^m + τ f, где Λ — оператор
+// разностной схемы SolverModel. При постоянном τ матрица слева не меняется:
+// она собирается и раскладывается один раз (prepare), а каждый шаг — это
+// явная правая часть, совмещённая с прямым ходом по готовому разложению,
+// и обратный ход: O(n) без делений и выделений памяти.
+// Снимки решения пишутся в файл по мере счёта и в памяти не накапливаются.
+class TimeStepper {
+public:
+    enum class Scheme {
+        BackwardEuler, // θ = 1: первый порядок, монотонна при любом τ
+        CrankNicolson  // θ = 1/2: второй порядок
+    };
+
+    struct Options {
+        Scheme scheme = Scheme::CrankNicolson;
+        double tau = 1e-3;
+        long long steps = 1000;
+        // Снимок каждые snapshotEvery шагов, а также начальный и конечный; 0 — только они
+        long long snapshotEvery = 0;
+        // Файл снимков: запись — t, затем n + 1 значений u, всё double; пусто — не писать
+        std::string snapshotPath;
+    };
+
+    struct Summary {
+        long long steps;
+        double time;
+        long long snapshots;
+        double lastChange;      // max |u^{m+1} - u^m| на последнем шаге
+        double stationaryError; // max |u - v| для аналитического решения v; NaN без него
+    };
+
+    explicit TimeStepper(std::shared_ptr<const ProblemKernels> problem);
+
+    // Сборка и разложение для сетки из n разбиений; повторный вызов
+    // с теми же параметрами ничего не делает
+    void prepare(int n, double mu1, double mu2, Scheme scheme, double tau);
+    bool isPrepared() const { return !m_p.empty(); }
+
+    // Шаг u^m -> u^{m+1} по готовому разложению; u из n + 1 значений.
+    // Возвращает max |u^{m+1} - u^m|
+    double step(std::vector<double>& u);
+
+    // prepare и options.steps шагов от начального условия u. Пустое u
+    // заменяется линейной функцией между mu1 и mu2
+    Summary run(int n, double mu1, double mu2, std::vector<double>& u, const Options& options);
+
+private:
+    std::shared_ptr<const ProblemKernels> m_problem;
+    int m_n = 0;
+    double m_mu1 = 0.0;
+    double m_mu2 = 0.0;
+    Scheme m_scheme = Scheme::CrankNicolson;
+    double m_tau = 0.0;
+
+    // Явная часть: rhs_i = alpha_i u_{i-1} + beta_i u_i + gamma_i u_{i+1} + g_i
+    std::vector<double> m_alpha;
+    std::vector<double> m_beta;
+    std::vector<double> m_gamma;
+    std::vector<double> m_g;
+
+    // Разложение неявной матрицы (как SolverModel::Factorization)
+    std::vector<double> m_a;
+    std::vector<double> m_p;
+    std::vector<double> m_invDenom;
+    std::vector<double> m_q; // Прямой ход по правой части
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cmath>
+
+// Элементарные функции без ветвлений и вызовов libm: в циклах по узлам
+// компилятор векторизует их (SSE2/AVX), в отличие от std::sin.
+// Используют точное округление double, поэтому несовместимы с -ffast-math.
+
+namespace vecmath {
+
+// Округление к ближайшему целому через сдвиг мантиссы; |x| < 2^51
+inline double roundToInteger(double x) {
+    const double shifter = 0x1.8p52;
+    return (x + shifter) - shifter;
+}
+
+// sin(pi * x) по схеме Cephes: точная редукция x = k + r, |r| <= 1/2,
+// и многочлен Тейлора степени 21 по r для sin(pi r); погрешность порядка ulp
+inline double sinPi(double x) {
+    const double k = roundToInteger(x);
+    const double r = x - k;
+    const double z = r * r;
+
+    // sin(pi r) = pi r * sum (-1)^m pi^(2m) r^(2m) / (2m+1)!, m = 0..10
+    double p = 1.7165384749821432e-10;
+    p = p * z - 7.3047118222177750e-09;
+    p = p * z + 2.5312174041370274e-07;
+    p = p * z - 6.9758736616563807e-06;
+    p = p * z + 1.4842879303107100e-04;
+    p = p * z - 2.3460810354558235e-03;
+    p = p * z + 2.6147847817654800e-02;
+    p = p * z - 1.9075182412208422e-01;
+    p = p * z + 8.1174242528335361e-01;
+    p = p * z - 1.6449340668482264e+00;
+    p = p * z + 1.0;
+    const double sinPiR = 3.141592653589793 * r * p;
+
+    // (-1)^k: разность k - 2 round(k / 2) равна 0 для чётного k и ±1 для нечётного
+    const double parity = k - 2.0 * roundToInteger(0.5 * k);
+    return (1.0 - 2.0 * std::fabs(parity)) * sinPiR;
+}
+
+} // namespace vecmath
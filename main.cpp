@@ -1,10 +1,26 @@
 #include "mainwindow.h"
+#include "SolverLog.hpp"
 
 #include <QApplication>
+#include <QDebug>
+
+// Журнал ядра выводится через обработчик сообщений Qt, как и остальной журнал GUI
+static void qtLogSink(SolverLogLevel level, const char* message, void*)
+{
+    switch (level) {
+    case SolverLogLevel::Debug: qDebug().noquote() << QString::fromUtf8(message); break;
+    case SolverLogLevel::Info: qInfo().noquote() << QString::fromUtf8(message); break;
+    case SolverLogLevel::Warning: qWarning().noquote() << QString::fromUtf8(message); break;
+    case SolverLogLevel::Error: qCritical().noquote() << QString::fromUtf8(message); break;
+    case SolverLogLevel::Off: break;
+    }
+}
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    setSolverLogSink(qtLogSink);
+    setSolverLogLevel(SolverLogLevel::Debug);
     MainWindow w;
     w.show();
     return a.exec();
@@ -1,4 +1,5 @@
 #include "MainWindow.h"
+#include "ResultCache.hpp"
 #include "SolverModel.hpp"
 
 MainWindow::MainWindow(QWidget* parent)
@@ -6,6 +7,9 @@ MainWindow::MainWindow(QWidget* parent)
     m_model(new SolverModel),
     m_widget(new SolverWidget(this)) {
 
+    // Повторные расчёты с теми же параметрами берутся из кэша
+    m_model->setCache(std::make_shared<ResultCache>());
+
     // Установка модели для виджета
     m_widget->setModel(m_model);
 
@@ -1,24 +1,30 @@
-QT       += core gui charts
+QT       += core gui charts concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+include(SolverLibrary.pri)
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    ChartDecimation.cpp \
     MainTaskWidget.cpp \
-    SolverModel.cpp \
+    ResultTableModel.cpp \
+    SolverRunner.cpp \
     SolverWidget.cpp \
     TestTaskWidget.cpp \
     main.cpp \
     mainwindow.cpp
 
 HEADERS += \
+    ChartDecimation.hpp \
     MainTaskWidget.hpp \
-    SolverModel.hpp \
+    ResultTableModel.hpp \
+    SolverRunner.hpp \
     SolverWidget.hpp \
     TestTaskWidget.hpp \
     mainwindow.h
@@ -0,0 +1,11 @@
+# Все цели: библиотека ядра, затем использующие её GUI и CLI; бенчмарк собирает ядро сам
+TEMPLATE = subdirs
+
+SUBDIRS = core gui cli bench
+
+core.file = thomasSolver.pro
+gui.file = thomasAlgorithm.pro
+gui.depends = core
+cli.file = thomasAlgorithmCli.pro
+cli.depends = core
+bench.file = thomasAlgorithmBench.pro
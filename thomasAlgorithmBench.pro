@@ -0,0 +1,11 @@
+# Микробенчмарки ядер решателя (JSON-отчёт, сравнение с базовым прогоном)
+# Ядро компилируется вместе с бенчмарком, всегда с оптимизацией, а не берётся из библиотеки
+CONFIG += c++17 console release thread
+CONFIG -= app_bundle debug qt
+
+TARGET = thomasAlgorithmBench
+
+include(SolverCore.pri)
+
+SOURCES += \
+    SolverBenchmark.cpp
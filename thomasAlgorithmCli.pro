@@ -0,0 +1,15 @@
+# Консольный пакетный запуск решателя без Qt и дисплея
+CONFIG += c++17 console
+CONFIG -= app_bundle qt
+
+TARGET = thomasAlgorithmCli
+
+include(SolverLibrary.pri)
+
+SOURCES += \
+    SolverCli.cpp
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,10 @@
+# Численное ядро как статическая библиотека без Qt: C++ API (SolverModel.hpp и др.)
+# и C API (SolverCApi.h) для GUI, консольных целей и внешних служб
+TEMPLATE = lib
+
+CONFIG += c++17 staticlib thread
+CONFIG -= qt
+
+TARGET = thomasSolver
+
+include(SolverCore.pri)